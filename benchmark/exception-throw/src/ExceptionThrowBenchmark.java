@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class ExceptionThrowBenchmark {
+    // Preallocated, so that the benchmarks measure delivery rather than stack trace filling.
+    static final ControlFlowException EXCEPTION = new ControlFlowException();
+
+    static class ControlFlowException extends RuntimeException {
+        ControlFlowException() {
+            super(null, null, false, false);
+        }
+    }
+
+    // Not final, so the compiler cannot remove the throw.
+    int depthToThrow = 0;
+
+    int recurse(int depth, int value) {
+        if (depth == depthToThrow) {
+            throw EXCEPTION;
+        }
+        try {
+            return recurse(depth - 1, value + 1);
+        } catch (IllegalStateException e) {
+            // Not taken: the exception is only caught at the top.
+            return -1;
+        }
+    }
+
+    int throwThrough(int frames, int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            try {
+                sum += recurse(frames, i);
+            } catch (ControlFlowException e) {
+                ++sum;
+            }
+        }
+        return sum;
+    }
+
+    public int timeThrowThrough1Frame(int count) {
+        return throwThrough(1, count);
+    }
+
+    public int timeThrowThrough5Frames(int count) {
+        return throwThrough(5, count);
+    }
+
+    public int timeThrowThrough10Frames(int count) {
+        return throwThrough(10, count);
+    }
+
+    public int timeThrowThrough20Frames(int count) {
+        return throwThrough(20, count);
+    }
+}
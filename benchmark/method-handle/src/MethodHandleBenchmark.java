@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+
+public class MethodHandleBenchmark {
+    static final MethodHandle STATIC_ADD;
+    static final MethodHandle VIRTUAL_ADD;
+    static final MethodHandle PRIVATE_ADD;
+
+    static {
+        try {
+            MethodHandles.Lookup lookup = MethodHandles.lookup();
+            MethodType type = MethodType.methodType(int.class, int.class, int.class);
+            STATIC_ADD = lookup.findStatic(MethodHandleBenchmark.class, "staticAdd", type);
+            VIRTUAL_ADD = lookup.findVirtual(MethodHandleBenchmark.class, "virtualAdd", type);
+            PRIVATE_ADD = lookup.findSpecial(
+                MethodHandleBenchmark.class, "privateAdd", type, MethodHandleBenchmark.class);
+        } catch (ReflectiveOperationException e) {
+            throw new Error(e);
+        }
+    }
+
+    // Not final, so the compiler cannot know the target.
+    MethodHandle staticAdd = STATIC_ADD;
+
+    static int staticAdd(int a, int b) {
+        return a + b;
+    }
+
+    int virtualAdd(int a, int b) {
+        return a + b;
+    }
+
+    private int privateAdd(int a, int b) {
+        return a + b;
+    }
+
+    public int timeDirectCall(int count) throws Throwable {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum = staticAdd(sum, i);
+        }
+        return sum;
+    }
+
+    public int timeInvokeExactConstantStatic(int count) throws Throwable {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum = (int) STATIC_ADD.invokeExact(sum, i);
+        }
+        return sum;
+    }
+
+    public int timeInvokeExactConstantVirtual(int count) throws Throwable {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum = (int) VIRTUAL_ADD.invokeExact(this, sum, i);
+        }
+        return sum;
+    }
+
+    public int timeInvokeExactConstantPrivate(int count) throws Throwable {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum = (int) PRIVATE_ADD.invokeExact(this, sum, i);
+        }
+        return sum;
+    }
+
+    public int timeInvokeExactNonConstant(int count) throws Throwable {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum = (int) staticAdd.invokeExact(sum, i);
+        }
+        return sum;
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class NewInstanceBenchmark {
+    static class Empty {}
+
+    static class Point {
+        int x;
+        int y;
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static class Node {
+        Object value;
+        Node next;
+        Node(Object value, Node next) {
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    // Keep the allocated objects reachable so that they are not optimized away.
+    public static Object sink;
+
+    public void timeNewEmpty(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new Empty();
+        }
+    }
+
+    public void timeNewPoint(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new Point(i, count);
+        }
+    }
+
+    public void timeNewLinkedNodes(int count) {
+        Node head = null;
+        for (int i = 0; i < count; ++i) {
+            head = new Node(head, (i & 63) == 0 ? null : head);
+        }
+        sink = head;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class SimdKernelsBenchmark {
+    private static final int SIZE = 4096;
+
+    private final byte[] bytes1 = new byte[SIZE];
+    private final byte[] bytes2 = new byte[SIZE];
+    private final short[] shorts1 = new short[SIZE];
+    private final short[] shorts2 = new short[SIZE];
+    private final int[] ints1 = new int[SIZE];
+    private final int[] ints2 = new int[SIZE];
+    private final long[] longs = new long[SIZE];
+    private final float[] floats1 = new float[SIZE];
+    private final float[] floats2 = new float[SIZE];
+
+    // Keep the results reachable so that the kernels are not optimized away.
+    public static long sink;
+
+    public SimdKernelsBenchmark() {
+        for (int i = 0; i < SIZE; ++i) {
+            bytes1[i] = (byte) i;
+            bytes2[i] = (byte) (i * 7);
+            shorts1[i] = (short) (i * 3);
+            shorts2[i] = (short) (-i);
+            ints1[i] = i;
+            ints2[i] = SIZE - i;
+            longs[i] = i * 31L;
+            floats1[i] = i * 0.25f;
+            floats2[i] = i * 0.5f;
+        }
+    }
+
+    public void timeAddInts(int count) {
+        for (int c = 0; c < count; ++c) {
+            for (int i = 0; i < SIZE; ++i) {
+                ints1[i] = ints1[i] + ints2[i];
+            }
+        }
+    }
+
+    public void timeMulBytes(int count) {
+        for (int c = 0; c < count; ++c) {
+            for (int i = 0; i < SIZE; ++i) {
+                bytes1[i] = (byte) (bytes1[i] * bytes2[i]);
+            }
+        }
+    }
+
+    public void timeSaxpy(int count) {
+        for (int c = 0; c < count; ++c) {
+            for (int i = 0; i < SIZE; ++i) {
+                floats1[i] = floats1[i] * 1.5f + floats2[i];
+            }
+        }
+    }
+
+    public void timeSumLongs(int count) {
+        long sum = 0;
+        for (int c = 0; c < count; ++c) {
+            for (int i = 0; i < SIZE; ++i) {
+                sum += longs[i];
+            }
+        }
+        sink = sum;
+    }
+
+    public void timeDotProductShorts(int count) {
+        int sum = 0;
+        for (int c = 0; c < count; ++c) {
+            for (int i = 0; i < SIZE; ++i) {
+                sum += shorts1[i] * shorts2[i];
+            }
+        }
+        sink = sum;
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class StackWalkBenchmark {
+    // Creating a Throwable walks the stack to record its internal stack trace.
+    static int walk(int depth) {
+        if (depth == 0) {
+            return new Throwable().hashCode() & 1;
+        }
+        return walk(depth - 1) + 1;
+    }
+
+    static int walkAtDepth(int depth, int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += walk(depth);
+        }
+        return sum;
+    }
+
+    public int timeWalkDepth1(int count) {
+        return walkAtDepth(1, count);
+    }
+
+    public int timeWalkDepth10(int count) {
+        return walkAtDepth(10, count);
+    }
+
+    public int timeWalkDepth50(int count) {
+        return walkAtDepth(50, count);
+    }
+
+    public int timeGetStackTraceDepth10(int count) {
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += getStackTraceLength(10);
+        }
+        return sum;
+    }
+
+    static int getStackTraceLength(int depth) {
+        if (depth == 0) {
+            return Thread.currentThread().getStackTrace().length;
+        }
+        return getStackTraceLength(depth - 1);
+    }
+}
@@ -59,6 +59,9 @@ func globalFlags(ctx android.LoadHookContext) ([]string, []string) {
 	if ctx.Config().IsEnvTrue("ART_USE_CXX_INTERPRETER") {
 		cflags = append(cflags, "-DART_USE_CXX_INTERPRETER=1")
 	}
+	if ctx.Config().IsEnvTrue("ART_USE_THREADED_INTERPRETER") {
+		cflags = append(cflags, "-DART_USE_THREADED_INTERPRETER=1")
+	}
 
 	if !ctx.Config().IsEnvFalse("ART_USE_READ_BARRIER") && ctx.Config().ArtUseReadBarrier() {
 		// Used to change the read barrier type. Valid values are BAKER, BROOKS,
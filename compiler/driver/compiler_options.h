@@ -345,6 +345,10 @@ class CompilerOptions final {
     return dump_pass_timings_;
   }
 
+  const std::string& GetDumpPassProfileFileName() const {
+    return dump_pass_profile_file_name_;
+  }
+
   bool GetDumpStats() const {
     return dump_stats_;
   }
@@ -357,6 +361,10 @@ class CompilerOptions final {
     return resolve_startup_const_strings_;
   }
 
+  bool LoopVersioning() const {
+    return loop_versioning_;
+  }
+
   ProfileMethodsCheck CheckProfiledMethodsCompiled() const {
     return check_profiled_methods_;
   }
@@ -416,6 +424,7 @@ class CompilerOptions final {
   bool dump_timings_;
   bool dump_pass_timings_;
   bool dump_stats_;
+  std::string dump_pass_profile_file_name_;
 
   // When using a profile file only the top K% of the profiled samples will be compiled.
   double top_k_profile_threshold_;
@@ -463,6 +472,10 @@ class CompilerOptions final {
   // Whether we attempt to run class initializers for app image classes.
   bool initialize_app_image_classes_;
 
+  // Whether loop optimization unswitches loops on invariant conditions and versions loops
+  // for bounds check elimination, which AOT code then prefers over deoptimization.
+  bool loop_versioning_;
+
   // When running profile-guided compilation, check that methods intended to be compiled end
   // up compiled and are not punted.
   ProfileMethodsCheck check_profiled_methods_;
@@ -93,6 +93,7 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
   }
   map.AssignIfExists(Base::ResolveStartupConstStrings, &options->resolve_startup_const_strings_);
   map.AssignIfExists(Base::InitializeAppImageClasses, &options->initialize_app_image_classes_);
+  map.AssignIfExists(Base::LoopVersioning, &options->loop_versioning_);
   if (map.Exists(Base::CheckProfiledMethods)) {
     options->check_profiled_methods_ = *map.Get(Base::CheckProfiledMethods);
   }
@@ -106,6 +107,8 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
     options->dump_pass_timings_ = true;
   }
 
+  map.AssignIfExists(Base::DumpPassProfile, &options->dump_pass_profile_file_name_);
+
   if (map.Exists(Base::DumpStats)) {
     options->dump_stats_ = true;
   }
@@ -178,6 +181,13 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
       .Define({"--count-hotness-in-compiled-code"})
           .IntoKey(Map::CountHotnessInCompiledCode)
 
+      .Define({"--loop-versioning", "--no-loop-versioning"})
+          .WithValues({true, false})
+          .WithHelp("Unswitch loops on invariant conditions and version loops with array accesses\n"
+                    "instead of guarding bounds check elimination with deoptimization in AOT\n"
+                    "code (disabled by default).")
+          .IntoKey(Map::LoopVersioning)
+
       .Define({"--check-profiled-methods=_"})
           .template WithType<ProfileMethodsCheck>()
           .WithValueMap({{"log", ProfileMethodsCheck::kLog},
@@ -193,6 +203,13 @@ inline void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                     " method.")
           .IntoKey(Map::DumpPassTimings)
 
+      .Define("--dump-pass-profile=_")
+          .template WithType<std::string>()
+          .WithHelp("Write the time and arena memory spent in each optimization pass, summed\n"
+                    "over all compiled methods, with the most expensive methods of each pass,\n"
+                    "as JSON to the specified file.")
+          .IntoKey(Map::DumpPassProfile)
+
       .Define({"--dump-stats"})
           .WithHelp("Display overall compilation statistics.")
           .IntoKey(Map::DumpStats)
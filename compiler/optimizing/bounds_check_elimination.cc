@@ -21,6 +21,7 @@
 #include "base/scoped_arena_allocator.h"
 #include "base/scoped_arena_containers.h"
 #include "induction_var_range.h"
+#include "loop_optimization.h"
 #include "nodes.h"
 #include "side_effects_analysis.h"
 
@@ -509,7 +510,8 @@ class BCEVisitor : public HGraphVisitor {
 
   BCEVisitor(HGraph* graph,
              const SideEffectsAnalysis& side_effects,
-             HInductionVarAnalysis* induction_analysis)
+             HInductionVarAnalysis* induction_analysis,
+             bool prefer_loop_versioning)
       : HGraphVisitor(graph),
         allocator_(graph->GetArenaStack()),
         maps_(graph->GetBlocks().size(),
@@ -528,6 +530,7 @@ class BCEVisitor : public HGraphVisitor {
         initial_block_size_(graph->GetBlocks().size()),
         side_effects_(side_effects),
         induction_range_(induction_analysis),
+        prefer_loop_versioning_(prefer_loop_versioning),
         next_(nullptr) {}
 
   void VisitBasicBlock(HBasicBlock* block) override {
@@ -909,6 +912,9 @@ class BCEVisitor : public HGraphVisitor {
       HLoopInformation* loop = bounds_check->GetBlock()->GetLoopInformation();
       bool needs_finite_test = false;
       bool needs_taken_test = false;
+      if (IsLeftToLoopVersioning(loop, bounds_check)) {
+        return;
+      }
       if (DynamicBCESeemsProfitable(loop, bounds_check->GetBlock()) &&
           induction_range_.CanGenerateRange(
               bounds_check, index, &needs_finite_test, &needs_taken_test) &&
@@ -1680,6 +1686,22 @@ class BCEVisitor : public HGraphVisitor {
     return false;
   }
 
+  /**
+   * Returns true if the bounds check is left to HLoopOptimization, which versions the loop
+   * into a copy without checks guarded by the same range test that loop-based dynamic bce
+   * would deoptimize on. The loop is marked so that loop optimization versions it whatever
+   * its size, which guarantees the check is removed.
+   */
+  bool IsLeftToLoopVersioning(HLoopInformation* loop, HBoundsCheck* bounds_check) {
+    if (!prefer_loop_versioning_ ||
+        loop == nullptr ||
+        !HLoopOptimization::CanVersionForBoundsCheck(GetGraph(), bounds_check, &induction_range_)) {
+      return false;
+    }
+    loop->SetHasBoundsChecksLeftToVersioning();
+    return true;
+  }
+
   /**
    * Returns true if the loop has early exits, which implies it may not cover
    * the full range computed by range analysis based on induction variables.
@@ -2035,6 +2057,9 @@ class BCEVisitor : public HGraphVisitor {
   // Range analysis based on induction variables.
   InductionVarRange induction_range_;
 
+  // Whether loop-based dynamic elimination is left to loop versioning.
+  const bool prefer_loop_versioning_;
+
   // Safe iteration.
   HInstruction* next_;
 
@@ -2051,7 +2076,7 @@ bool BoundsCheckElimination::Run() {
   // be bounded by a range at one instruction, it must be true that all uses of
   // that value dominated by that instruction fits in that range. Range of that
   // value can be narrowed further down in the dominator tree.
-  BCEVisitor visitor(graph_, side_effects_, induction_analysis_);
+  BCEVisitor visitor(graph_, side_effects_, induction_analysis_, prefer_loop_versioning_);
   for (size_t i = 0, size = graph_->GetReversePostOrder().size(); i != size; ++i) {
     HBasicBlock* current = graph_->GetReversePostOrder()[i];
     if (visitor.IsAddedBlock(current)) {
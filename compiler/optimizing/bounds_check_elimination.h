@@ -29,10 +29,12 @@ class BoundsCheckElimination : public HOptimization {
   BoundsCheckElimination(HGraph* graph,
                          const SideEffectsAnalysis& side_effects,
                          HInductionVarAnalysis* induction_analysis,
-                         const char* name = kBoundsCheckEliminationPassName)
+                         const char* name = kBoundsCheckEliminationPassName,
+                         bool prefer_loop_versioning = false)
       : HOptimization(graph, name),
         side_effects_(side_effects),
-        induction_analysis_(induction_analysis) {}
+        induction_analysis_(induction_analysis),
+        prefer_loop_versioning_(prefer_loop_versioning) {}
 
   bool Run() override;
 
@@ -42,6 +44,10 @@ class BoundsCheckElimination : public HOptimization {
   const SideEffectsAnalysis& side_effects_;
   HInductionVarAnalysis* induction_analysis_;
 
+  // Whether loop-based dynamic elimination is left to loop versioning in HLoopOptimization,
+  // which keeps a fully checked copy of the loop instead of deoptimizing (e.g. for AOT code).
+  const bool prefer_loop_versioning_;
+
   DISALLOW_COPY_AND_ASSIGN(BoundsCheckElimination);
 };
 
@@ -40,7 +40,7 @@ class BoundsCheckEliminationTest : public OptimizingUnitTest {
 
   ~BoundsCheckEliminationTest() { }
 
-  void RunBCE() {
+  void RunBCE(bool prefer_loop_versioning = false) {
     graph_->BuildDominatorTree();
 
     InstructionSimplifier(graph_, /* codegen= */ nullptr).Run();
@@ -53,7 +53,12 @@ class BoundsCheckEliminationTest : public OptimizingUnitTest {
     HInductionVarAnalysis induction(graph_);
     induction.Run();
 
-    BoundsCheckElimination(graph_, side_effects, &induction).Run();
+    BoundsCheckElimination(
+        graph_,
+        side_effects,
+        &induction,
+        BoundsCheckElimination::kBoundsCheckEliminationPassName,
+        prefer_loop_versioning).Run();
   }
 
   HGraph* graph_;
@@ -469,6 +474,82 @@ TEST_F(BoundsCheckEliminationTest, LoopArrayBoundsElimination1f) {
   ASSERT_TRUE(IsRemoved(bounds_check));
 }
 
+// for (int i=0; i<n; i++) { array[i] = 10; }
+static HInstruction* BuildSSAGraphWithParameterBound(HGraph* graph, ArenaAllocator* allocator) {
+  HBasicBlock* entry = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(entry);
+  graph->SetEntryBlock(entry);
+  HInstruction* parameter = new (allocator) HParameterValue(
+      graph->GetDexFile(), dex::TypeIndex(0), 0, DataType::Type::kReference);  // array
+  HInstruction* n = new (allocator) HParameterValue(
+      graph->GetDexFile(), dex::TypeIndex(0), 1, DataType::Type::kInt32);  // n
+  entry->AddInstruction(parameter);
+  entry->AddInstruction(n);
+
+  HInstruction* constant_0 = graph->GetIntConstant(0);
+  HInstruction* constant_1 = graph->GetIntConstant(1);
+  HInstruction* constant_10 = graph->GetIntConstant(10);
+
+  HBasicBlock* block = new (allocator) HBasicBlock(graph);
+  graph->AddBlock(block);
+  entry->AddSuccessor(block);
+  block->AddInstruction(new (allocator) HGoto());
+
+  HBasicBlock* loop_header = new (allocator) HBasicBlock(graph);
+  HBasicBlock* loop_body = new (allocator) HBasicBlock(graph);
+  HBasicBlock* exit = new (allocator) HBasicBlock(graph);
+
+  graph->AddBlock(loop_header);
+  graph->AddBlock(loop_body);
+  graph->AddBlock(exit);
+  block->AddSuccessor(loop_header);
+  loop_header->AddSuccessor(exit);       // true successor
+  loop_header->AddSuccessor(loop_body);  // false successor
+  loop_body->AddSuccessor(loop_header);
+
+  HPhi* phi = new (allocator) HPhi(allocator, 0, 0, DataType::Type::kInt32);
+  HInstruction* cmp = new (allocator) HGreaterThanOrEqual(phi, n);
+  HInstruction* if_inst = new (allocator) HIf(cmp);
+  loop_header->AddPhi(phi);
+  loop_header->AddInstruction(cmp);
+  loop_header->AddInstruction(if_inst);
+  phi->AddInput(constant_0);
+
+  HInstruction* null_check = new (allocator) HNullCheck(parameter, 0);
+  HInstruction* array_length = new (allocator) HArrayLength(null_check, 0);
+  HInstruction* bounds_check = new (allocator) HBoundsCheck(phi, array_length, 0);
+  HInstruction* array_set = new (allocator) HArraySet(
+      null_check, bounds_check, constant_10, DataType::Type::kInt32, 0);
+
+  HInstruction* add = new (allocator) HAdd(DataType::Type::kInt32, phi, constant_1);
+  loop_body->AddInstruction(null_check);
+  loop_body->AddInstruction(array_length);
+  loop_body->AddInstruction(bounds_check);
+  loop_body->AddInstruction(array_set);
+  loop_body->AddInstruction(add);
+  loop_body->AddInstruction(new (allocator) HGoto());
+  phi->AddInput(add);
+
+  exit->AddInstruction(new (allocator) HExit());
+
+  return bounds_check;
+}
+
+TEST_F(BoundsCheckEliminationTest, LoopArrayBoundsLeftToLoopVersioning) {
+  // for (int i=0; i<n; i++) { array[i] = 10; // Left to loop versioning. }
+  HInstruction* bounds_check = BuildSSAGraphWithParameterBound(graph_, GetAllocator());
+  RunBCE(/* prefer_loop_versioning= */ true);
+  ASSERT_FALSE(IsRemoved(bounds_check));
+  HLoopInformation* loop_info = bounds_check->GetBlock()->GetLoopInformation();
+  ASSERT_TRUE(loop_info != nullptr);
+  ASSERT_TRUE(loop_info->HasBoundsChecksLeftToVersioning());
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      ASSERT_FALSE(it.Current()->IsDeoptimize());
+    }
+  }
+}
+
 // for (int i=array.length; i>0; i+=increment) { array[i-1] = 10; }
 static HInstruction* BuildSSAGraph2(HGraph *graph,
                                     ArenaAllocator* allocator,
@@ -291,6 +291,15 @@ void CodeGenerator::EmitJitRootPatches(uint8_t* code ATTRIBUTE_UNUSED,
   DCHECK_EQ(code_generation_data_->GetNumberOfJitClassRoots(), 0u);
 }
 
+bool CodeGenerator::CanInlineTlabAllocation(HNewInstance* new_instance) {
+  // Only resolved, instantiable, non-finalizable classes use `kQuickAllocObjectInitialized`.
+  // Like the assembly entrypoints, the inline fast path reads the object size from
+  // `mirror::Class::object_size_alloc_fast_path_`, which is too large for the TLAB size check
+  // to succeed until the class is visibly initialized. An empty TLAB (when the current
+  // allocator does not use TLABs) also fails the check and takes the slow path.
+  return new_instance->GetEntrypoint() == kQuickAllocObjectInitialized;
+}
+
 uint32_t CodeGenerator::GetArrayLengthOffset(HArrayLength* array_length) {
   return array_length->IsStringLength()
       ? mirror::String::CountOffset().Uint32Value()
@@ -398,8 +407,12 @@ void CodeGenerator::Compile(CodeAllocator* allocator) {
     disasm_info_->SetFrameEntryInterval(frame_start, GetAssembler()->CodeSize());
   }
 
+  size_t cold_code_start = static_cast<size_t>(-1);
   for (size_t e = block_order_->size(); current_block_index_ < e; ++current_block_index_) {
     HBasicBlock* block = (*block_order_)[current_block_index_];
+    if (current_block_index_ == first_cold_block_index_) {
+      cold_code_start = GetAssembler()->CodeSize();
+    }
     // Don't generate code for an empty block. Its predecessors will branch to its successor
     // directly. Also, the label of that block will not be emitted, so this helps catch
     // errors where we reference that label.
@@ -423,7 +436,14 @@ void CodeGenerator::Compile(CodeAllocator* allocator) {
     }
   }
 
+  if (cold_code_start == static_cast<size_t>(-1)) {
+    cold_code_start = GetAssembler()->CodeSize();
+  }
   GenerateSlowPaths();
+  MaybeRecordStat(stats_, MethodCompilationStat::kHotCodeBytes, cold_code_start);
+  MaybeRecordStat(stats_,
+                  MethodCompilationStat::kColdCodeBytes,
+                  GetAssembler()->CodeSize() - cold_code_start);
 
   // Emit catch stack maps at the end of the stack map stream as expected by the
   // runtime exception handler.
@@ -466,9 +486,10 @@ void CodeGenerator::InitializeCodeGeneration(size_t number_of_spill_slots,
                                              size_t maximum_safepoint_spill_size,
                                              size_t number_of_out_slots,
                                              const ArenaVector<HBasicBlock*>& block_order) {
-  block_order_ = &block_order;
   DCHECK(!block_order.empty());
   DCHECK(block_order[0] == GetGraph()->GetEntryBlock());
+  ComputeHotColdBlockOrder(block_order);
+  block_order_ = &hot_cold_block_order_;
   ComputeSpillMask();
   first_register_slot_in_slow_path_ = RoundUp(
       (number_of_out_slots + number_of_spill_slots) * kVRegSize, GetPreferredSlotsAlignment());
@@ -489,6 +510,66 @@ void CodeGenerator::InitializeCodeGeneration(size_t number_of_spill_slots,
   }
 }
 
+// Catch handlers, blocks ending with a throw and blocks only reachable from such
+// blocks are considered cold: they are moved after all other blocks, right before
+// the slow paths, so that the frequently executed code is laid out contiguously.
+// The relative order within the hot and within the cold blocks is preserved.
+void CodeGenerator::ComputeHotColdBlockOrder(const ArenaVector<HBasicBlock*>& block_order) {
+  ScopedArenaAllocator allocator(GetGraph()->GetArenaStack());
+  ArenaBitVector cold_blocks(
+      &allocator, GetGraph()->GetBlocks().size(), /* expandable= */ false, kArenaAllocCodeGenerator);
+  size_t last_hot_block_index = 0u;
+  for (size_t i = 0, size = block_order.size(); i != size; ++i) {
+    HBasicBlock* block = block_order[i];
+    if (block->IsEntryBlock()) {
+      continue;
+    }
+    bool is_cold = block->IsCatchBlock() || block->GetLastInstruction()->IsThrow();
+    if (!is_cold && !block->IsLoopHeader()) {
+      // The block order is a reverse post order, so all forward predecessors of
+      // `block` have already been classified. Predecessors that come later (as in
+      // irreducible loops) are not marked yet and conservatively keep `block` hot.
+      is_cold = std::all_of(block->GetPredecessors().begin(),
+                            block->GetPredecessors().end(),
+                            [&](HBasicBlock* predecessor) {
+                              return cold_blocks.IsBitSet(predecessor->GetBlockId());
+                            });
+    }
+    if (is_cold) {
+      cold_blocks.SetBit(block->GetBlockId());
+    } else {
+      last_hot_block_index = i;
+    }
+  }
+
+  // Cold blocks after the last hot block keep their position, so they are not counted as moved.
+  size_t number_of_moved_cold_blocks = 0u;
+  for (size_t i = 0; i != last_hot_block_index; ++i) {
+    HBasicBlock* block = block_order[i];
+    if (cold_blocks.IsBitSet(block->GetBlockId()) &&
+        !block->IsSingleJump() &&
+        !block->IsExitBlock()) {
+      ++number_of_moved_cold_blocks;
+    }
+  }
+
+  hot_cold_block_order_.clear();
+  hot_cold_block_order_.reserve(block_order.size());
+  for (HBasicBlock* block : block_order) {
+    if (!cold_blocks.IsBitSet(block->GetBlockId())) {
+      hot_cold_block_order_.push_back(block);
+    }
+  }
+  first_cold_block_index_ = hot_cold_block_order_.size();
+  for (HBasicBlock* block : block_order) {
+    if (cold_blocks.IsBitSet(block->GetBlockId())) {
+      hot_cold_block_order_.push_back(block);
+    }
+  }
+  DCHECK_EQ(hot_cold_block_order_.size(), block_order.size());
+  MaybeRecordStat(stats_, MethodCompilationStat::kColdBlocksMoved, number_of_moved_cold_blocks);
+}
+
 void CodeGenerator::CreateCommonInvokeLocationSummary(
     HInvoke* invoke, InvokeDexCallingConventionVisitor* visitor) {
   ArenaAllocator* allocator = invoke->GetBlock()->GetGraph()->GetAllocator();
@@ -1055,6 +1136,8 @@ CodeGenerator::CodeGenerator(HGraph* graph,
       fpu_callee_save_mask_(fpu_callee_save_mask),
       block_order_(nullptr),
       disasm_info_(nullptr),
+      hot_cold_block_order_(graph->GetAllocator()->Adapter(kArenaAllocCodeGenerator)),
+      first_cold_block_index_(0u),
       stats_(stats),
       graph_(graph),
       compiler_options_(compiler_options),
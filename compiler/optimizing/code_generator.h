@@ -425,6 +425,10 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
   bool IsBlockedCoreRegister(size_t i) { return blocked_core_registers_[i]; }
   bool IsBlockedFloatingPointRegister(size_t i) { return blocked_fpu_registers_[i]; }
 
+  // Returns whether `new_instance` can bump-allocate from the thread-local allocation
+  // buffer inline and call the allocation entrypoint only when that fails.
+  static bool CanInlineTlabAllocation(HNewInstance* new_instance);
+
   // Helper that returns the offset of the array's length field.
   // Note: Besides the normal arrays, we also use the HArrayLength for
   // accessing the String's `count` field in String intrinsics.
@@ -494,6 +498,21 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
     return type == DataType::Type::kReference && !value->IsNullConstant();
   }
 
+  // Same as above, but also honors the decision of the write barrier elimination pass.
+  static bool StoreNeedsWriteBarrier(DataType::Type type,
+                                     HInstruction* value,
+                                     WriteBarrierKind write_barrier_kind) {
+    return write_barrier_kind != WriteBarrierKind::kDontEmit &&
+           StoreNeedsWriteBarrier(type, value);
+  }
+
+  // Returns the write barrier kind of a field store. Only instance field stores are
+  // considered by the write barrier elimination pass.
+  static WriteBarrierKind GetWriteBarrierKind(HInstruction* instruction) {
+    return instruction->IsInstanceFieldSet()
+        ? instruction->AsInstanceFieldSet()->GetWriteBarrierKind()
+        : WriteBarrierKind::kEmitWithNullCheck;
+  }
 
   // Performs checks pertaining to an InvokeRuntime call.
   void ValidateInvokeRuntime(QuickEntrypointEnum entrypoint,
@@ -820,9 +839,16 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
   DisassemblyInformation* disasm_info_;
 
  private:
+  // The linear order with cold blocks moved to the end, see `ComputeHotColdBlockOrder()`.
+  ArenaVector<HBasicBlock*> hot_cold_block_order_;
+
+  // Index in `hot_cold_block_order_` of the first cold block.
+  size_t first_cold_block_index_;
+
   class CodeGenerationData;
 
   void InitializeCodeGenerationData();
+  void ComputeHotColdBlockOrder(const ArenaVector<HBasicBlock*>& block_order);
   size_t GetStackOffsetOfSavedRegister(size_t index);
   void GenerateSlowPaths();
   void BlockIfInRegister(Location location, bool is_out = false) const;
@@ -355,6 +355,41 @@ class LoadStringSlowPathARM64 : public SlowPathCodeARM64 {
   DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathARM64);
 };
 
+class NewInstanceSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  explicit NewInstanceSlowPathARM64(HNewInstance* instruction)
+      : SlowPathCodeARM64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    CodeGeneratorARM64* arm64_codegen = down_cast<CodeGeneratorARM64*>(codegen);
+
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    arm64_codegen->MoveLocation(LocationFrom(calling_convention.GetRegisterAt(0)),
+                                locations->InAt(0),
+                                DataType::Type::kReference);
+    HNewInstance* new_instance = instruction_->AsNewInstance();
+    arm64_codegen->InvokeRuntime(
+        new_instance->GetEntrypoint(), instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickAllocObjectInitialized, void*, mirror::Class*>();
+    DataType::Type type = instruction_->GetType();
+    arm64_codegen->MoveLocation(locations->Out(), calling_convention.GetReturnLocation(type), type);
+
+    RestoreLiveRegisters(codegen, locations);
+
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "NewInstanceSlowPathARM64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NewInstanceSlowPathARM64);
+};
+
 class NullCheckSlowPathARM64 : public SlowPathCodeARM64 {
  public:
   explicit NullCheckSlowPathARM64(HNullCheck* instr) : SlowPathCodeARM64(instr) {}
@@ -2125,8 +2160,13 @@ void InstructionCodeGeneratorARM64::HandleFieldSet(HInstruction* instruction,
     }
   }
 
-  if (CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1))) {
-    codegen_->MarkGCCard(obj, Register(value), value_can_be_null);
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  if (CodeGenerator::StoreNeedsWriteBarrier(
+          field_type, instruction->InputAt(1), write_barrier_kind)) {
+    codegen_->MarkGCCard(
+        obj,
+        Register(value),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
   }
 
   if (is_predicated) {
@@ -5674,6 +5714,14 @@ void InstructionCodeGeneratorARM64::VisitNewArray(HNewArray* instruction) {
 }
 
 void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    // The object is written before the last use of the class.
+    locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+    return;
+  }
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
       instruction, LocationSummary::kCallOnMainOnly);
   InvokeRuntimeCallingConvention calling_convention;
@@ -5682,11 +5730,57 @@ void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorARM64::VisitNewInstance(HNewInstance* instruction) {
-  codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
-  CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    GenerateInlineTlabAllocation(instruction);
+  } else {
+    codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+  }
   codegen_->MaybeGenerateMarkingRegisterCheck(/* code= */ __LINE__);
 }
 
+// Same fast path as `art_quick_alloc_object_initialized_tlab`, without the call.
+void InstructionCodeGeneratorARM64::GenerateInlineTlabAllocation(HNewInstance* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  Register cls = InputRegisterAt(instruction, 0);
+  Register out = XRegisterFrom(locations->Out());
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) NewInstanceSlowPathARM64(instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  Register temp = temps.AcquireX();
+  Register temp2 = temps.AcquireX();
+  // Instrumented allocation entrypoints must see every allocation.
+  int32_t instrumented_offset =
+      Thread::AllocEntrypointsInstrumentedOffset<kArm64PointerSize>().Int32Value();
+  __ Ldr(temp2.W(), MemOperand(tr, instrumented_offset));
+  __ Cbnz(temp2.W(), slow_path->GetEntryLabel());
+  // Both the size and the TLAB position fit in 32 bits, so an overflowing sum
+  // is simply past the end of the TLAB.
+  __ Ldr(temp.W(), HeapOperand(cls, mirror::Class::ObjectSizeAllocFastPathOffset()));
+  __ Ldr(out, MemOperand(tr, Thread::ThreadLocalPosOffset<kArm64PointerSize>().Int32Value()));
+  __ Ldr(temp2, MemOperand(tr, Thread::ThreadLocalEndOffset<kArm64PointerSize>().Int32Value()));
+  __ Add(temp, temp, out);
+  __ Cmp(temp, temp2);
+  __ B(hi, slow_path->GetEntryLabel());
+  __ Str(temp, MemOperand(tr, Thread::ThreadLocalPosOffset<kArm64PointerSize>().Int32Value()));
+  __ Ldr(temp, MemOperand(tr, Thread::ThreadLocalObjectsOffset<kArm64PointerSize>().Int32Value()));
+  __ Add(temp, temp, 1);
+  __ Str(temp, MemOperand(tr, Thread::ThreadLocalObjectsOffset<kArm64PointerSize>().Int32Value()));
+  // Store the class pointer in the header and publish it, as the entrypoint does.
+  Register class_ref = cls;
+  if (kPoisonHeapReferences) {
+    __ Mov(temp.W(), cls);
+    GetAssembler()->PoisonHeapReference(temp.W());
+    class_ref = temp.W();
+  }
+  __ Str(class_ref, HeapOperand(out.W(), mirror::Object::ClassOffset()));
+  codegen_->GenerateMemoryBarrier(MemBarrierKind::kStoreStore);
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void LocationsBuilderARM64::VisitNot(HNot* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
   locations->SetInAt(0, Location::RequiresRegister());
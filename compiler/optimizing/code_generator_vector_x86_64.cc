@@ -25,6 +25,15 @@ namespace x86_64 {
 // NOLINT on __ macro to suppress wrong warning/fix (misc-macro-parentheses) from clang-tidy.
 #define __ down_cast<X86_64Assembler*>(GetAssembler())->  // NOLINT
 
+// With AVX2, vector operations fill the full 256-bit ymm registers.
+static bool IsYmmVector(HVecOperation* instruction) {
+  return instruction->GetVectorNumberOfBytes() == 4 * kX86_64WordSize;
+}
+
+static YmmRegister AsYmm(Location location) {
+  return YmmRegister(location.AsFpuRegister<XmmRegister>());
+}
+
 void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
   HInstruction* input = instruction->InputAt(0);
@@ -65,11 +74,48 @@ void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar
     return;
   }
 
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastb(ymm_dst, dst);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastw(ymm_dst, dst);
+        break;
+      case DataType::Type::kInt32:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
+        __ vpbroadcastd(ymm_dst, dst);
+        break;
+      case DataType::Type::kInt64:
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ true);
+        __ vpbroadcastq(ymm_dst, dst);
+        break;
+      case DataType::Type::kFloat32:
+        DCHECK(locations->InAt(0).Equals(locations->Out()));
+        __ vbroadcastss(ymm_dst, dst);
+        break;
+      case DataType::Type::kFloat64:
+        DCHECK(locations->InAt(0).Equals(locations->Out()));
+        __ vbroadcastsd(ymm_dst, dst);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
       __ punpcklbw(dst, dst);
       __ punpcklwd(dst, dst);
@@ -77,28 +123,28 @@ void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar
       break;
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
       __ punpcklwd(dst, dst);
       __ pshufd(dst, dst, Immediate(0));
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ false);
       __ pshufd(dst, dst, Immediate(0));
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*64-bit*/ true);
       __ punpcklqdq(dst, dst);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       DCHECK(locations->InAt(0).Equals(locations->Out()));
       __ shufps(dst, dst, Immediate(0));
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       DCHECK(locations->InAt(0).Equals(locations->Out()));
       __ shufpd(dst, dst, Immediate(0));
       break;
@@ -144,17 +190,16 @@ void InstructionCodeGeneratorX86_64::VisitVecExtractScalar(HVecExtractScalar* in
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(locations->Out().AsRegister<CpuRegister>(), src, /*64-bit*/ false);
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(locations->Out().AsRegister<CpuRegister>(), src, /*64-bit*/ true);
       break;
     case DataType::Type::kFloat32:
     case DataType::Type::kFloat64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 4u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       DCHECK(locations->InAt(0).Equals(locations->Out()));  // no code required
       break;
     default:
@@ -201,10 +246,16 @@ void InstructionCodeGeneratorX86_64::VisitVecReduce(HVecReduce* instruction) {
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       switch (instruction->GetReductionKind()) {
         case HVecReduce::kSum:
-          __ movaps(dst, src);
+          if (IsYmmVector(instruction)) {
+            // Fold the upper 128-bit lane into the lower one first.
+            __ vextracti128(dst, YmmRegister(src), Immediate(1));
+            __ vpaddd(dst, dst, src);
+          } else {
+            __ movaps(dst, src);
+          }
           __ phaddd(dst, dst);
           __ phaddd(dst, dst);
           break;
@@ -216,12 +267,19 @@ void InstructionCodeGeneratorX86_64::VisitVecReduce(HVecReduce* instruction) {
       }
       break;
     case DataType::Type::kInt64: {
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
       switch (instruction->GetReductionKind()) {
         case HVecReduce::kSum:
-          __ movaps(tmp, src);
-          __ movaps(dst, src);
+          if (IsYmmVector(instruction)) {
+            // Fold the upper 128-bit lane into the lower one first.
+            __ vextracti128(dst, YmmRegister(src), Immediate(1));
+            __ vpaddq(dst, dst, src);
+            __ movaps(tmp, dst);
+          } else {
+            __ movaps(tmp, src);
+            __ movaps(dst, src);
+          }
           __ punpckhqdq(tmp, tmp);
           __ paddq(dst, tmp);
           break;
@@ -248,8 +306,12 @@ void InstructionCodeGeneratorX86_64::VisitVecCnv(HVecCnv* instruction) {
   DataType::Type from = instruction->GetInputType();
   DataType::Type to = instruction->GetResultType();
   if (from == DataType::Type::kInt32 && to == DataType::Type::kFloat32) {
-    DCHECK_EQ(4u, instruction->GetVectorLength());
-    __ cvtdq2ps(dst, src);
+    DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
+    if (IsYmmVector(instruction)) {
+      __ vcvtdq2ps(YmmRegister(dst), YmmRegister(src));
+    } else {
+      __ cvtdq2ps(dst, src);
+    }
   } else {
     LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
   }
@@ -263,36 +325,73 @@ void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpsubq(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vxorps(ymm_dst, ymm_dst, ymm_dst);
+        __ vsubps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vxorpd(ymm_dst, ymm_dst, ymm_dst);
+        __ vsubpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pxor(dst, dst);
       __ psubb(dst, src);
       break;
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pxor(dst, dst);
       __ psubw(dst, src);
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pxor(dst, dst);
       __ psubd(dst, src);
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pxor(dst, dst);
       __ psubq(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ xorps(dst, dst);
       __ subps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ xorpd(dst, dst);
       __ subpd(dst, src);
       break;
@@ -304,8 +403,8 @@ void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
 
 void LocationsBuilderX86_64::VisitVecAbs(HVecAbs* instruction) {
   CreateVecUnOpLocations(GetGraph()->GetAllocator(), instruction);
-  // Integral-abs requires a temporary for the comparison.
-  if (instruction->GetPackedType() == DataType::Type::kInt32) {
+  // Integral-abs requires a temporary for the comparison (AVX2 has a direct vpabsd).
+  if (instruction->GetPackedType() == DataType::Type::kInt32 && !IsYmmVector(instruction)) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
 }
@@ -314,9 +413,39 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kInt8:
+        __ vpabsb(ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpabsw(ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpabsd(ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vpsrld(ymm_dst, ymm_dst, Immediate(1));
+        __ vandps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vpsrlq(ymm_dst, ymm_dst, Immediate(1));
+        __ vandpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt32: {
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
       __ movaps(dst, src);
       __ pxor(tmp, tmp);
@@ -326,13 +455,13 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
       break;
     }
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pcmpeqb(dst, dst);  // all ones
       __ psrld(dst, Immediate(1));
       __ andps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pcmpeqb(dst, dst);  // all ones
       __ psrlq(dst, Immediate(1));
       __ andpd(dst, src);
@@ -355,9 +484,45 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
   LocationSummary* locations = instruction->GetLocations();
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool: {  // special case boolean-not
+        YmmRegister tmp = AsYmm(locations->GetTemp(0));
+        __ vpxor(ymm_dst, ymm_dst, ymm_dst);
+        __ vpcmpeqb(tmp, tmp, tmp);  // all ones
+        __ vpsubb(ymm_dst, ymm_dst, tmp);  // 32 x one
+        __ vpxor(ymm_dst, ymm_dst, ymm_src);
+        break;
+      }
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vpxor(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vxorps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vpcmpeqb(ymm_dst, ymm_dst, ymm_dst);  // all ones
+        __ vxorpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool: {  // special case boolean-not
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
       __ pxor(dst, dst);
       __ pcmpeqb(tmp, tmp);  // all ones
@@ -371,18 +536,17 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
     case DataType::Type::kInt16:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pcmpeqb(dst, dst);  // all ones
       __ pxor(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pcmpeqb(dst, dst);  // all ones
       __ xorps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pcmpeqb(dst, dst);  // all ones
       __ xorpd(dst, src);
       break;
@@ -452,31 +616,63 @@ void InstructionCodeGeneratorX86_64::VisitVecAdd(HVecAdd* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpaddb(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpaddw(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpaddd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpaddq(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vaddps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vaddpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpaddb(dst, other_src, src) : __ paddb(dst, src);
       break;
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpaddw(dst, other_src, src) : __ paddw(dst, src);
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpaddd(dst, other_src, src) : __ paddd(dst, src);
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpaddq(dst, other_src, src) : __ paddq(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vaddps(dst, other_src, src) : __ addps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vaddpd(dst, other_src, src) : __ addpd(dst, src);
       break;
     default:
@@ -494,21 +690,44 @@ void InstructionCodeGeneratorX86_64::VisitVecSaturationAdd(HVecSaturationAdd* in
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpaddusb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpaddsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpaddusw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpaddsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ paddusb(dst, src);
       break;
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ paddsb(dst, src);
       break;
     case DataType::Type::kUint16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ paddusw(dst, src);
       break;
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ paddsw(dst, src);
       break;
     default:
@@ -529,13 +748,30 @@ void InstructionCodeGeneratorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instruct
 
   DCHECK(instruction->IsRounded());
 
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpavgb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpavgw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pavgb(dst, src);
       break;
     case DataType::Type::kUint16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pavgw(dst, src);
       break;
     default:
@@ -559,31 +795,63 @@ void InstructionCodeGeneratorX86_64::VisitVecSub(HVecSub* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+        __ vpsubb(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsubw(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpsubd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kInt64:
+        __ vpsubq(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vsubps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vsubpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpsubb(dst, other_src, src) : __ psubb(dst, src);
       break;
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpsubw(dst, other_src, src) : __ psubw(dst, src);
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpsubd(dst, other_src, src) : __ psubd(dst, src);
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpsubq(dst, other_src, src) : __ psubq(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vsubps(dst, other_src, src) : __ subps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vsubpd(dst, other_src, src) : __ subpd(dst, src);
       break;
     default:
@@ -601,21 +869,44 @@ void InstructionCodeGeneratorX86_64::VisitVecSaturationSub(HVecSaturationSub* in
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpsubusb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpsubsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpsubusw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpsubsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psubusb(dst, src);
       break;
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psubsb(dst, src);
       break;
     case DataType::Type::kUint16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psubusw(dst, src);
       break;
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psubsw(dst, src);
       break;
     default:
@@ -630,6 +921,11 @@ void LocationsBuilderX86_64::VisitVecMul(HVecMul* instruction) {
   } else {
     CreateVecBinOpLocations(GetGraph()->GetAllocator(), instruction);
   }
+  // There is no byte multiplication; it is composed from word multiplications.
+  if (IsYmmVector(instruction) && DataType::Size(instruction->GetPackedType()) == 1u) {
+    instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+    instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
+  }
 }
 
 void InstructionCodeGeneratorX86_64::VisitVecMul(HVecMul* instruction) {
@@ -639,22 +935,63 @@ void InstructionCodeGeneratorX86_64::VisitVecMul(HVecMul* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8: {
+        // Multiply the odd and the even bytes as words and merge the low bytes of the products.
+        YmmRegister tmp1 = AsYmm(locations->GetTemp(0));
+        YmmRegister tmp2 = AsYmm(locations->GetTemp(1));
+        __ vpsrlw(tmp1, ymm_other_src, Immediate(8));
+        __ vpsrlw(tmp2, ymm_src, Immediate(8));
+        __ vpmullw(tmp1, tmp1, tmp2);
+        __ vpsllw(tmp1, tmp1, Immediate(8));  // odd products
+        __ vpmullw(ymm_dst, ymm_other_src, ymm_src);
+        __ vpcmpeqb(tmp2, tmp2, tmp2);
+        __ vpsrlw(tmp2, tmp2, Immediate(8));  // 16 x 0x00ff
+        __ vpand(ymm_dst, ymm_dst, tmp2);  // even products
+        __ vpor(ymm_dst, ymm_dst, tmp1);
+        break;
+      }
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpmullw(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpmulld(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vmulps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vmulpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpmullw(dst, other_src, src) : __ pmullw(dst, src);
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpmulld(dst, other_src, src): __ pmulld(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vmulps(dst, other_src, src) : __ mulps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vmulpd(dst, other_src, src) : __ mulpd(dst, src);
       break;
     default:
@@ -678,13 +1015,31 @@ void InstructionCodeGeneratorX86_64::VisitVecDiv(HVecDiv* instruction) {
   XmmRegister other_src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kFloat32:
+        __ vdivps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vdivpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vdivps(dst, other_src, src) : __ divps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vdivpd(dst, other_src, src) : __ divpd(dst, src);
       break;
     default:
@@ -702,38 +1057,73 @@ void InstructionCodeGeneratorX86_64::VisitVecMin(HVecMin* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpminub(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpminsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpminuw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpminsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint32:
+        __ vpminud(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpminsd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vminps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vminpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pminub(dst, src);
       break;
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pminsb(dst, src);
       break;
     case DataType::Type::kUint16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pminuw(dst, src);
       break;
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pminsw(dst, src);
       break;
     case DataType::Type::kUint32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pminud(dst, src);
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pminsd(dst, src);
       break;
     // Next cases are sloppy wrt 0.0 vs -0.0.
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ minps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ minpd(dst, src);
       break;
     default:
@@ -751,38 +1141,73 @@ void InstructionCodeGeneratorX86_64::VisitVecMax(HVecMax* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint8:
+        __ vpmaxub(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt8:
+        __ vpmaxsb(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint16:
+        __ vpmaxuw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt16:
+        __ vpmaxsw(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kUint32:
+        __ vpmaxud(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kInt32:
+        __ vpmaxsd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vmaxps(ymm_dst, ymm_dst, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vmaxpd(ymm_dst, ymm_dst, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pmaxub(dst, src);
       break;
     case DataType::Type::kInt8:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pmaxsb(dst, src);
       break;
     case DataType::Type::kUint16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pmaxuw(dst, src);
       break;
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pmaxsw(dst, src);
       break;
     case DataType::Type::kUint32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pmaxud(dst, src);
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pmaxsd(dst, src);
       break;
     // Next cases are sloppy wrt 0.0 vs -0.0.
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ maxps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ maxpd(dst, src);
       break;
     default:
@@ -806,6 +1231,33 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpand(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vandps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vandpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -814,16 +1266,15 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
     case DataType::Type::kInt16:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpand(dst, other_src, src) : __ pand(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vandps(dst, other_src, src) : __ andps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vandpd(dst, other_src, src) : __ andpd(dst, src);
       break;
     default:
@@ -847,6 +1298,33 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpandn(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vandnps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vandnpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -855,16 +1333,15 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
     case DataType::Type::kInt16:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpandn(dst, other_src, src) : __ pandn(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vandnps(dst, other_src, src) : __ andnps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vandnpd(dst, other_src, src) : __ andnpd(dst, src);
       break;
     default:
@@ -888,6 +1365,33 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpor(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vorps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vorpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -896,16 +1400,15 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
     case DataType::Type::kInt16:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpor(dst, other_src, src) : __ por(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vorps(dst, other_src, src) : __ orps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vorpd(dst, other_src, src) : __ orpd(dst, src);
       break;
     default:
@@ -929,6 +1432,33 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   DCHECK(cpu_has_avx || other_src == dst);
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_other_src(other_src);
+    YmmRegister ymm_src(src);
+    YmmRegister ymm_dst(dst);
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kBool:
+      case DataType::Type::kUint8:
+      case DataType::Type::kInt8:
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+      case DataType::Type::kInt32:
+      case DataType::Type::kInt64:
+        __ vpxor(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat32:
+        __ vxorps(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      case DataType::Type::kFloat64:
+        __ vxorpd(ymm_dst, ymm_other_src, ymm_src);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
     case DataType::Type::kUint8:
@@ -937,16 +1467,15 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
     case DataType::Type::kInt16:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vpxor(dst, other_src, src) : __ pxor(dst, src);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vxorps(dst, other_src, src) : __ xorps(dst, src);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       cpu_has_avx ? __ vxorpd(dst, other_src, src) : __ xorpd(dst, src);
       break;
     default:
@@ -982,18 +1511,39 @@ void InstructionCodeGeneratorX86_64::VisitVecShl(HVecShl* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    Immediate shift(static_cast<int8_t>(value));
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsllw(ymm_dst, ymm_dst, shift);
+        break;
+      case DataType::Type::kInt32:
+        __ vpslld(ymm_dst, ymm_dst, shift);
+        break;
+      case DataType::Type::kInt64:
+        __ vpsllq(ymm_dst, ymm_dst, shift);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psllw(dst, Immediate(static_cast<int8_t>(value)));
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ pslld(dst, Immediate(static_cast<int8_t>(value)));
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psllq(dst, Immediate(static_cast<int8_t>(value)));
       break;
     default:
@@ -1011,14 +1561,32 @@ void InstructionCodeGeneratorX86_64::VisitVecShr(HVecShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    Immediate shift(static_cast<int8_t>(value));
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsraw(ymm_dst, ymm_dst, shift);
+        break;
+      case DataType::Type::kInt32:
+        __ vpsrad(ymm_dst, ymm_dst, shift);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psraw(dst, Immediate(static_cast<int8_t>(value)));
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psrad(dst, Immediate(static_cast<int8_t>(value)));
       break;
     default:
@@ -1036,18 +1604,39 @@ void InstructionCodeGeneratorX86_64::VisitVecUShr(HVecUShr* instruction) {
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    YmmRegister ymm_dst(dst);
+    Immediate shift(static_cast<int8_t>(value));
+    switch (instruction->GetPackedType()) {
+      case DataType::Type::kUint16:
+      case DataType::Type::kInt16:
+        __ vpsrlw(ymm_dst, ymm_dst, shift);
+        break;
+      case DataType::Type::kInt32:
+        __ vpsrld(ymm_dst, ymm_dst, shift);
+        break;
+      case DataType::Type::kInt64:
+        __ vpsrlq(ymm_dst, ymm_dst, shift);
+        break;
+      default:
+        LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+        UNREACHABLE();
+    }
+    return;
+  }
+
   switch (instruction->GetPackedType()) {
     case DataType::Type::kUint16:
     case DataType::Type::kInt16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psrlw(dst, Immediate(static_cast<int8_t>(value)));
       break;
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psrld(dst, Immediate(static_cast<int8_t>(value)));
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ psrlq(dst, Immediate(static_cast<int8_t>(value)));
       break;
     default:
@@ -1113,19 +1702,19 @@ void InstructionCodeGeneratorX86_64::VisitVecSetScalars(HVecSetScalars* instruct
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
     case DataType::Type::kInt32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>());
       break;
     case DataType::Type::kInt64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>());  // is 64-bit
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movss(dst, locations->InAt(0).AsFpuRegister<XmmRegister>());
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       __ movsd(dst, locations->InAt(0).AsFpuRegister<XmmRegister>());
       break;
     default:
@@ -1190,9 +1779,12 @@ void InstructionCodeGeneratorX86_64::VisitVecDotProd(HVecDotProd* instruction) {
   XmmRegister right = locations->InAt(2).AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt32: {
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
-      if (!cpu_has_avx) {
+      if (IsYmmVector(instruction)) {
+        __ vpmaddwd(YmmRegister(tmp), YmmRegister(left), YmmRegister(right));
+        __ vpaddd(YmmRegister(acc), YmmRegister(acc), YmmRegister(tmp));
+      } else if (!cpu_has_avx) {
         __ movaps(tmp, right);
         __ pmaddwd(tmp, left);
         __ paddd(acc, tmp);
@@ -1255,10 +1847,83 @@ static Address VecAddress(LocationSummary* locations, size_t size, bool is_strin
   return CodeGeneratorX86_64::ArrayAddress(base.AsRegister<CpuRegister>(), index, scale, offset);
 }
 
+void InstructionCodeGeneratorX86_64::GenerateYmmLoad(HVecLoad* instruction,
+                                                     const Address& address) {
+  LocationSummary* locations = instruction->GetLocations();
+  YmmRegister reg = AsYmm(locations->Out());
+  bool is_aligned32 = instruction->GetAlignment().IsAlignedAt(32);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kInt16:  // (short) s.charAt(.) can yield HVecLoad/Int16/StringCharAt.
+    case DataType::Type::kUint16:
+      // Special handling of compressed/uncompressed string load.
+      if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+        NearLabel done, not_compressed;
+        // Test compression bit.
+        static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                      "Expecting 0=compressed, 1=uncompressed");
+        uint32_t count_offset = mirror::String::CountOffset().Uint32Value();
+        __ testb(Address(locations->InAt(0).AsRegister<CpuRegister>(), count_offset), Immediate(1));
+        __ j(kNotZero, &not_compressed);
+        // Zero extend 16 compressed bytes into 16 chars.
+        __ movdqu(reg.AsXmmRegister(), VecAddress(locations, 1, instruction->IsStringCharAt()));
+        __ vpmovzxbw(reg, reg.AsXmmRegister());
+        __ jmp(&done);
+        // Load 16 direct uncompressed chars.
+        __ Bind(&not_compressed);
+        __ vmovdqu(reg, address);
+        __ Bind(&done);
+        return;
+      }
+      FALLTHROUGH_INTENDED;
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      is_aligned32 ? __ vmovdqa(reg, address) : __ vmovdqu(reg, address);
+      break;
+    case DataType::Type::kFloat32:
+      is_aligned32 ? __ vmovaps(reg, address) : __ vmovups(reg, address);
+      break;
+    case DataType::Type::kFloat64:
+      is_aligned32 ? __ vmovapd(reg, address) : __ vmovupd(reg, address);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
+void InstructionCodeGeneratorX86_64::GenerateYmmStore(HVecStore* instruction,
+                                                      const Address& address) {
+  YmmRegister reg = AsYmm(instruction->GetLocations()->InAt(2));
+  bool is_aligned32 = instruction->GetAlignment().IsAlignedAt(32);
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kBool:
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+    case DataType::Type::kInt32:
+    case DataType::Type::kInt64:
+      is_aligned32 ? __ vmovdqa(address, reg) : __ vmovdqu(address, reg);
+      break;
+    case DataType::Type::kFloat32:
+      is_aligned32 ? __ vmovaps(address, reg) : __ vmovups(address, reg);
+      break;
+    case DataType::Type::kFloat64:
+      is_aligned32 ? __ vmovapd(address, reg) : __ vmovupd(address, reg);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+}
+
 void LocationsBuilderX86_64::VisitVecLoad(HVecLoad* instruction) {
   CreateVecMemLocations(GetGraph()->GetAllocator(), instruction, /*is_load*/ true);
-  // String load requires a temporary for the compressed load.
-  if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+  // String load requires a temporary for the compressed load (except for the AVX2 zero extend).
+  if (mirror::kUseStringCompression && instruction->IsStringCharAt() && !IsYmmVector(instruction)) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
 }
@@ -1268,11 +1933,15 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
   size_t size = DataType::Size(instruction->GetPackedType());
   Address address = VecAddress(locations, size, instruction->IsStringCharAt());
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    GenerateYmmLoad(instruction, address);
+    return;
+  }
   bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
   switch (instruction->GetPackedType()) {
     case DataType::Type::kInt16:  // (short) s.charAt(.) can yield HVecLoad/Int16/StringCharAt.
     case DataType::Type::kUint16:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       // Special handling of compressed/uncompressed string load.
       if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
         NearLabel done, not_compressed;
@@ -1300,16 +1969,15 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
     case DataType::Type::kInt8:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       is_aligned16 ? __ movdqa(reg, address) : __ movdqu(reg, address);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       is_aligned16 ? __ movaps(reg, address) : __ movups(reg, address);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       is_aligned16 ? __ movapd(reg, address) : __ movupd(reg, address);
       break;
     default:
@@ -1327,6 +1995,10 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
   size_t size = DataType::Size(instruction->GetPackedType());
   Address address = VecAddress(locations, size, /*is_string_char_at*/ false);
   XmmRegister reg = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  if (IsYmmVector(instruction)) {
+    GenerateYmmStore(instruction, address);
+    return;
+  }
   bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
   switch (instruction->GetPackedType()) {
     case DataType::Type::kBool:
@@ -1336,16 +2008,15 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
     case DataType::Type::kInt16:
     case DataType::Type::kInt32:
     case DataType::Type::kInt64:
-      DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       is_aligned16 ? __ movdqa(address, reg) : __ movdqu(address, reg);
       break;
     case DataType::Type::kFloat32:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       is_aligned16 ? __ movaps(address, reg) : __ movups(address, reg);
       break;
     case DataType::Type::kFloat64:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(codegen_->GetSIMDRegisterWidth(), instruction->GetVectorNumberOfBytes());
       is_aligned16 ? __ movapd(address, reg) : __ movupd(address, reg);
       break;
     default:
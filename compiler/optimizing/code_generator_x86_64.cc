@@ -311,6 +311,38 @@ class LoadClassSlowPathX86_64 : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(LoadClassSlowPathX86_64);
 };
 
+class NewInstanceSlowPathX86_64 : public SlowPathCode {
+ public:
+  explicit NewInstanceSlowPathX86_64(HNewInstance* instruction) : SlowPathCode(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    Location out = locations->Out();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(out.reg()));
+
+    CodeGeneratorX86_64* x86_64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    x86_64_codegen->Move(Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+                         locations->InAt(0));
+    HNewInstance* new_instance = instruction_->AsNewInstance();
+    x86_64_codegen->InvokeRuntime(
+        new_instance->GetEntrypoint(), instruction_, instruction_->GetDexPc(), this);
+    CheckEntrypointTypes<kQuickAllocObjectInitialized, void*, mirror::Class*>();
+    x86_64_codegen->Move(out, Location::RegisterLocation(RAX));
+
+    RestoreLiveRegisters(codegen, locations);
+    __ jmp(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "NewInstanceSlowPathX86_64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NewInstanceSlowPathX86_64);
+};
+
 class LoadStringSlowPathX86_64 : public SlowPathCode {
  public:
   explicit LoadStringSlowPathX86_64(HLoadString* instruction) : SlowPathCode(instruction) {}
@@ -1053,6 +1085,7 @@ void CodeGeneratorX86_64::LoadMethod(MethodLoadKind load_kind, Location temp, HI
 void CodeGeneratorX86_64::GenerateStaticOrDirectCall(
     HInvokeStaticOrDirect* invoke, Location temp, SlowPathCode* slow_path) {
   // All registers are assumed to be correctly set up.
+  MaybeEmitVZeroUpper();
 
   Location callee_method = temp;  // For all kinds except kRecursive, callee will be in temp.
   switch (invoke->GetMethodLoadKind()) {
@@ -1146,6 +1179,7 @@ void CodeGeneratorX86_64::GenerateStaticOrDirectCall(
 
 void CodeGeneratorX86_64::GenerateVirtualCall(
     HInvokeVirtual* invoke, Location temp_in, SlowPathCode* slow_path) {
+  MaybeEmitVZeroUpper();
   CpuRegister temp = temp_in.AsRegister<CpuRegister>();
   size_t method_offset = mirror::Class::EmbeddedVTableEntryOffset(
       invoke->GetVTableIndex(), kX86_64PointerSize).SizeValue();
@@ -1376,7 +1410,9 @@ size_t CodeGeneratorX86_64::RestoreCoreRegister(size_t stack_index, uint32_t reg
 }
 
 size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (HasYmmSIMD()) {
+    __ vmovups(Address(CpuRegister(RSP), stack_index), YmmRegister(XmmRegister(reg_id)));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   } else {
     __ movsd(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
@@ -1385,7 +1421,9 @@ size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32
 }
 
 size_t CodeGeneratorX86_64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (HasYmmSIMD()) {
+    __ vmovups(YmmRegister(XmmRegister(reg_id)), Address(CpuRegister(RSP), stack_index));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   } else {
     __ movsd(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
@@ -1412,9 +1450,18 @@ void CodeGeneratorX86_64::InvokeRuntimeWithoutRecordingPcInfo(int32_t entry_poin
 }
 
 void CodeGeneratorX86_64::GenerateInvokeRuntime(int32_t entry_point_offset) {
+  MaybeEmitVZeroUpper();
   __ gs()->call(Address::Absolute(entry_point_offset, /* no_rip= */ true));
 }
 
+void CodeGeneratorX86_64::MaybeEmitVZeroUpper() {
+  // Live ymm values never cross a call: slow paths save them in full, and
+  // the callee-save xmm registers only preserve their low 64 bits anyway.
+  if (HasYmmSIMD()) {
+    __ vzeroupper();
+  }
+}
+
 static constexpr int kNumberOfCpuRegisterPairs = 0;
 // Use a fake return address register to mimic Quick.
 static constexpr Register kFakeReturnRegister = Register(kLastCpuRegister + 1);
@@ -1609,6 +1656,7 @@ void CodeGeneratorX86_64::GenerateFrameExit() {
       }
     }
   }
+  MaybeEmitVZeroUpper();
   __ ret();
   __ cfi().RestoreState();
   __ cfi().DefCFAOffset(GetFrameSize());
@@ -2884,6 +2932,7 @@ void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invo
     __ movq(hidden_reg.AsRegister<CpuRegister>(), temp);
   }
   // call temp->GetEntryPoint();
+  codegen_->MaybeEmitVZeroUpper();
   __ call(Address(
       temp, ArtMethod::EntryPointFromQuickCompiledCodeOffset(kX86_64PointerSize).SizeValue()));
 
@@ -4745,6 +4794,15 @@ void InstructionCodeGeneratorX86_64::VisitUShr(HUShr* ushr) {
 }
 
 void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    // The object is written before the last use of the class.
+    locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+    locations->AddTemp(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
       instruction, LocationSummary::kCallOnMainOnly);
   InvokeRuntimeCallingConvention calling_convention;
@@ -4753,11 +4811,56 @@ void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    GenerateInlineTlabAllocation(instruction);
+    return;
+  }
   codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
   CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+// Same fast path as `art_quick_alloc_object_initialized_tlab`, without the call.
+void InstructionCodeGeneratorX86_64::GenerateInlineTlabAllocation(HNewInstance* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister cls = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
+
+  SlowPathCode* slow_path = new (codegen_->GetScopedAllocator()) NewInstanceSlowPathX86_64(
+      instruction);
+  codegen_->AddSlowPath(slow_path);
+
+  // Instrumented allocation entrypoints must see every allocation.
+  __ gs()->cmpl(Address::Absolute(
+                    Thread::AllocEntrypointsInstrumentedOffset<kX86_64PointerSize>().Int32Value(),
+                    /* no_rip= */ true),
+                Immediate(0));
+  __ j(kNotEqual, slow_path->GetEntryLabel());
+  // Both the size and the TLAB position fit in 32 bits, so an overflowing sum
+  // is simply past the end of the TLAB.
+  __ movl(temp, Address(cls, mirror::Class::ObjectSizeAllocFastPathOffset().Int32Value()));
+  __ gs()->movq(out, Address::Absolute(
+      Thread::ThreadLocalPosOffset<kX86_64PointerSize>().Int32Value(), /* no_rip= */ true));
+  __ addq(temp, out);
+  __ gs()->cmpq(temp, Address::Absolute(
+      Thread::ThreadLocalEndOffset<kX86_64PointerSize>().Int32Value(), /* no_rip= */ true));
+  __ j(kAbove, slow_path->GetEntryLabel());
+  __ gs()->movq(Address::Absolute(
+      Thread::ThreadLocalPosOffset<kX86_64PointerSize>().Int32Value(), /* no_rip= */ true), temp);
+  __ gs()->movq(temp, Address::Absolute(
+      Thread::ThreadLocalObjectsOffset<kX86_64PointerSize>().Int32Value(), /* no_rip= */ true));
+  __ addq(temp, Immediate(1));
+  __ gs()->movq(Address::Absolute(
+      Thread::ThreadLocalObjectsOffset<kX86_64PointerSize>().Int32Value(), /* no_rip= */ true),
+      temp);
+  // Store the class pointer in the header. No fence needed for x86-64.
+  __ movl(temp, cls);
+  __ MaybePoisonHeapReference(temp);
+  __ movl(Address(out, mirror::Object::ClassOffset().Int32Value()), temp);
+  __ Bind(slow_path->GetExitLabel());
+}
+
 void LocationsBuilderX86_64::VisitNewArray(HNewArray* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
       instruction, LocationSummary::kCallOnMainOnly);
@@ -4999,8 +5102,8 @@ void LocationsBuilderX86_64::HandleFieldSet(HInstruction* instruction,
       new (GetGraph()->GetAllocator()) LocationSummary(instruction, LocationSummary::kNoCall);
   DataType::Type field_type = field_info.GetFieldType();
   bool is_volatile = field_info.IsVolatile();
-  bool needs_write_barrier =
-      CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(1));
+  bool needs_write_barrier = CodeGenerator::StoreNeedsWriteBarrier(
+      field_type, instruction->InputAt(1), CodeGenerator::GetWriteBarrierKind(instruction));
 
   locations->SetInAt(0, Location::RequiresRegister());
   if (DataType::IsFloatingPointType(instruction->InputAt(1)->GetType())) {
@@ -5153,10 +5256,17 @@ void InstructionCodeGeneratorX86_64::HandleFieldSet(HInstruction* instruction,
     codegen_->MaybeRecordImplicitNullCheck(instruction);
   }
 
-  if (CodeGenerator::StoreNeedsWriteBarrier(field_type, instruction->InputAt(value_index))) {
+  WriteBarrierKind write_barrier_kind = CodeGenerator::GetWriteBarrierKind(instruction);
+  if (CodeGenerator::StoreNeedsWriteBarrier(
+          field_type, instruction->InputAt(value_index), write_barrier_kind)) {
     CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
     CpuRegister card = locations->GetTemp(extra_temp_index).AsRegister<CpuRegister>();
-    codegen_->MarkGCCard(temp, card, base, value.AsRegister<CpuRegister>(), value_can_be_null);
+    codegen_->MarkGCCard(
+        temp,
+        card,
+        base,
+        value.AsRegister<CpuRegister>(),
+        value_can_be_null && write_barrier_kind == WriteBarrierKind::kEmitWithNullCheck);
   }
 
   if (is_volatile) {
@@ -5177,6 +5287,11 @@ void InstructionCodeGeneratorX86_64::HandleFieldSet(HInstruction* instruction,
   bool is_predicated =
       instruction->IsInstanceFieldSet() && instruction->AsInstanceFieldSet()->GetIsPredicatedSet();
 
+  // Without the write barrier temps, the temp for reference poisoning is the first one.
+  bool needs_write_barrier = CodeGenerator::StoreNeedsWriteBarrier(
+      field_type, instruction->InputAt(1), CodeGenerator::GetWriteBarrierKind(instruction));
+  uint32_t extra_temp_index = needs_write_barrier ? 1u : 0u;
+
   NearLabel pred_is_null;
   if (is_predicated) {
     __ testl(base, base);
@@ -5185,7 +5300,7 @@ void InstructionCodeGeneratorX86_64::HandleFieldSet(HInstruction* instruction,
 
   HandleFieldSet(instruction,
                  /*value_index=*/ 1,
-                 /*extra_temp_index=*/ 1,
+                 extra_temp_index,
                  field_type,
                  Address(base, offset),
                  base,
@@ -5940,15 +6055,20 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsSIMDStackSlot()) {
     if (destination.IsFpuRegister()) {
-      __ movups(destination.AsFpuRegister<XmmRegister>(),
-                Address(CpuRegister(RSP), source.GetStackIndex()));
+      if (codegen_->HasYmmSIMD()) {
+        __ vmovups(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                   Address(CpuRegister(RSP), source.GetStackIndex()));
+      } else {
+        __ movups(destination.AsFpuRegister<XmmRegister>(),
+                  Address(CpuRegister(RSP), source.GetStackIndex()));
+      }
     } else {
       DCHECK(destination.IsSIMDStackSlot());
-      size_t high = kX86_64WordSize;
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex()));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex()), CpuRegister(TMP));
-      __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + high));
-      __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + high), CpuRegister(TMP));
+      size_t simd_width = codegen_->GetSIMDRegisterWidth();
+      for (size_t offset = 0; offset < simd_width; offset += kX86_64WordSize) {
+        __ movq(CpuRegister(TMP), Address(CpuRegister(RSP), source.GetStackIndex() + offset));
+        __ movq(Address(CpuRegister(RSP), destination.GetStackIndex() + offset), CpuRegister(TMP));
+      }
     }
   } else if (source.IsConstant()) {
     HConstant* constant = source.GetConstant();
@@ -5996,7 +6116,13 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsFpuRegister()) {
     if (destination.IsFpuRegister()) {
-      __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      if (codegen_->HasYmmSIMD()) {
+        // The location does not tell whether this is a vector, so always copy the full ymm.
+        __ vmovaps(YmmRegister(destination.AsFpuRegister<XmmRegister>()),
+                   YmmRegister(source.AsFpuRegister<XmmRegister>()));
+      } else {
+        __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      }
     } else if (destination.IsStackSlot()) {
       __ movss(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
@@ -6004,9 +6130,14 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
       __ movsd(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
     } else {
-       DCHECK(destination.IsSIMDStackSlot());
-      __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
-                source.AsFpuRegister<XmmRegister>());
+      DCHECK(destination.IsSIMDStackSlot());
+      if (codegen_->HasYmmSIMD()) {
+        __ vmovups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                   YmmRegister(source.AsFpuRegister<XmmRegister>()));
+      } else {
+        __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                  source.AsFpuRegister<XmmRegister>());
+      }
     }
   }
 }
@@ -6041,12 +6172,20 @@ void ParallelMoveResolverX86_64::Exchange64(XmmRegister reg, int mem) {
   __ movd(reg, CpuRegister(TMP));
 }
 
-void ParallelMoveResolverX86_64::Exchange128(XmmRegister reg, int mem) {
-  size_t extra_slot = 2 * kX86_64WordSize;
+void ParallelMoveResolverX86_64::ExchangeSIMD(XmmRegister reg, int mem) {
+  size_t extra_slot = codegen_->GetSIMDRegisterWidth();
   __ subq(CpuRegister(RSP), Immediate(extra_slot));
-  __ movups(Address(CpuRegister(RSP), 0), XmmRegister(reg));
-  ExchangeMemory64(0, mem + extra_slot, 2);
-  __ movups(XmmRegister(reg), Address(CpuRegister(RSP), 0));
+  if (codegen_->HasYmmSIMD()) {
+    __ vmovups(Address(CpuRegister(RSP), 0), YmmRegister(reg));
+  } else {
+    __ movups(Address(CpuRegister(RSP), 0), XmmRegister(reg));
+  }
+  ExchangeMemory64(0, mem + extra_slot, extra_slot / kX86_64WordSize);
+  if (codegen_->HasYmmSIMD()) {
+    __ vmovups(YmmRegister(reg), Address(CpuRegister(RSP), 0));
+  } else {
+    __ movups(XmmRegister(reg), Address(CpuRegister(RSP), 0));
+  }
   __ addq(CpuRegister(RSP), Immediate(extra_slot));
 }
 
@@ -6102,6 +6241,13 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
     Exchange64(destination.AsRegister<CpuRegister>(), source.GetStackIndex());
   } else if (source.IsDoubleStackSlot() && destination.IsDoubleStackSlot()) {
     ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 1);
+  } else if (source.IsFpuRegister() && destination.IsFpuRegister() && codegen_->HasYmmSIMD()) {
+    // Swap the full ymm registers with the xor trick.
+    YmmRegister reg1(source.AsFpuRegister<XmmRegister>());
+    YmmRegister reg2(destination.AsFpuRegister<XmmRegister>());
+    __ vpxor(reg1, reg1, reg2);
+    __ vpxor(reg2, reg2, reg1);
+    __ vpxor(reg1, reg1, reg2);
   } else if (source.IsFpuRegister() && destination.IsFpuRegister()) {
     __ movd(CpuRegister(TMP), source.AsFpuRegister<XmmRegister>());
     __ movaps(source.AsFpuRegister<XmmRegister>(), destination.AsFpuRegister<XmmRegister>());
@@ -6115,11 +6261,13 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
   } else if (source.IsDoubleStackSlot() && destination.IsFpuRegister()) {
     Exchange64(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
   } else if (source.IsSIMDStackSlot() && destination.IsSIMDStackSlot()) {
-    ExchangeMemory64(destination.GetStackIndex(), source.GetStackIndex(), 2);
+    ExchangeMemory64(destination.GetStackIndex(),
+                     source.GetStackIndex(),
+                     codegen_->GetSIMDRegisterWidth() / kX86_64WordSize);
   } else if (source.IsFpuRegister() && destination.IsSIMDStackSlot()) {
-    Exchange128(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
+    ExchangeSIMD(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
   } else if (destination.IsFpuRegister() && source.IsSIMDStackSlot()) {
-    Exchange128(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
+    ExchangeSIMD(destination.AsFpuRegister<XmmRegister>(), source.GetStackIndex());
   } else {
     LOG(FATAL) << "Unimplemented swap between " << source << " and " << destination;
   }
@@ -167,7 +167,7 @@ class ParallelMoveResolverX86_64 : public ParallelMoveResolverWithSwap {
   void Exchange64(CpuRegister reg1, CpuRegister reg2);
   void Exchange64(CpuRegister reg, int mem);
   void Exchange64(XmmRegister reg, int mem);
-  void Exchange128(XmmRegister reg, int mem);
+  void ExchangeSIMD(XmmRegister reg, int mem);
   void ExchangeMemory32(int mem1, int mem2);
   void ExchangeMemory64(int mem1, int mem2, int num_of_qwords);
 
@@ -256,6 +256,7 @@ class InstructionCodeGeneratorX86_64 : public InstructionCodeGenerator {
   // is the block to branch to if the suspend check is not needed, and after
   // the suspend call.
   void GenerateSuspendCheck(HSuspendCheck* instruction, HBasicBlock* successor);
+  void GenerateInlineTlabAllocation(HNewInstance* instruction);
   void GenerateClassInitializationCheck(SlowPathCode* slow_path, CpuRegister class_reg);
   void GenerateBitstringTypeCheckCompare(HTypeCheckInstruction* check, CpuRegister temp);
   void HandleBitwiseOperation(HBinaryOperation* operation);
@@ -277,6 +278,10 @@ class InstructionCodeGeneratorX86_64 : public InstructionCodeGenerator {
   void GenerateMinMaxFP(LocationSummary* locations, bool is_min, DataType::Type type);
   void GenerateMinMax(HBinaryOperation* minmax, bool is_min);
 
+  // 256-bit (AVX2) vector memory operations.
+  void GenerateYmmLoad(HVecLoad* instruction, const Address& address);
+  void GenerateYmmStore(HVecStore* instruction, const Address& address);
+
   // Generate a heap reference load using one register `out`:
   //
   //   out <- *(out + offset)
@@ -384,9 +389,21 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   }
 
   size_t GetSIMDRegisterWidth() const override {
-    return 2 * kX86_64WordSize;
+    // With AVX2, vector code uses the full 256-bit ymm registers.
+    return GetInstructionSetFeatures().HasAVX2() ? 4 * kX86_64WordSize : 2 * kX86_64WordSize;
+  }
+
+  // Whether SIMD values of this method occupy full ymm registers (see GetSIMDRegisterWidth()).
+  bool HasYmmSIMD() const {
+    return GetGraph()->HasSIMD() && GetSIMDRegisterWidth() == 4 * kX86_64WordSize;
   }
 
+  // Clear the upper ymm state before leaving code that uses ymm registers, which avoids
+  // AVX-SSE transition penalties in legacy SSE code of callees and callers. This must be
+  // emitted before every call (direct, virtual, interface and runtime calls, the latter all
+  // going through GenerateInvokeRuntime()) and on frame exit.
+  void MaybeEmitVZeroUpper();
+
   HGraphVisitor* GetLocationBuilder() override {
     return &location_builder_;
   }
@@ -550,6 +550,7 @@ class HGraphVisualizerPrinter : public HGraphDelegateVisitor {
                                                       /* with type */ false);
     StartAttributeStream("field_type") << iset->GetFieldType();
     StartAttributeStream("predicated") << std::boolalpha << iset->GetIsPredicatedSet();
+    StartAttributeStream("write_barrier_kind") << iset->GetWriteBarrierKind();
   }
 
   void VisitStaticFieldGet(HStaticFieldGet* sget) override {
@@ -16,6 +16,7 @@
 
 #include "inliner.h"
 
+#include "art_field-inl.h"
 #include "art_method-inl.h"
 #include "base/enums.h"
 #include "base/logging.h"
@@ -34,6 +35,8 @@
 #include "jit/jit_code_cache.h"
 #include "mirror/class_loader.h"
 #include "mirror/dex_cache.h"
+#include "mirror/method_handle_impl-inl.h"
+#include "mirror/method_type-inl.h"
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
 #include "nodes.h"
@@ -64,6 +67,10 @@ static constexpr size_t kMaximumNumberOfCumulatedDexRegisters = 32;
 // much inlining compared to code locality.
 static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 
+// Scale the code item size limit of call sites that the profile reports as hot or cold.
+static constexpr size_t kHotCallSiteCodeUnitsMultiplier = 2;
+static constexpr size_t kColdCallSiteCodeUnitsDivisor = 4;
+
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
@@ -168,6 +175,15 @@ bool HInliner::Run() {
     for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
       HInstruction* next = instruction->GetNext();
       HInvoke* call = instruction->AsInvoke();
+      if (call != nullptr && call->GetIntrinsic() == Intrinsics::kMethodHandleInvokeExact) {
+        HInvoke* replacement = TryReplaceMethodHandleInvokeExact(call->AsInvokePolymorphic());
+        if (replacement != nullptr) {
+          didInline = true;
+          // The dex pc of a virtual replacement has no inline cache, so only try to inline
+          // calls with a known target.
+          call = replacement->IsInvokeVirtual() ? nullptr : replacement;
+        }
+      }
       // As long as the call is not intrinsified, it is worth trying to inline.
       if (call != nullptr && call->GetIntrinsic() == Intrinsics::kNone) {
         if (honor_noinline_directives) {
@@ -1275,6 +1291,236 @@ bool HInliner::TryDevirtualize(HInvoke* invoke_instruction,
 }
 
 
+// Returns whether the type of the call site `invoke` is exactly (`ptypes`...) -> `rtype`,
+// as `MethodHandle.invokeExact()` requires. `get_ptype(i)` returns the i-th parameter type.
+template <typename GetPType>
+static bool CallSiteTypeMatches(HInvokePolymorphic* invoke,
+                                ArtMethod* referrer,
+                                uint32_t number_of_ptypes,
+                                GetPType&& get_ptype,
+                                ObjPtr<mirror::Class> rtype)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  const DexFile& dex_file = *invoke->GetMethodReference().dex_file;
+  const dex::ProtoId& proto_id = dex_file.GetProtoId(invoke->GetProtoIndex());
+  if (rtype == nullptr ||
+      class_linker->LookupResolvedType(proto_id.return_type_idx_, referrer) != rtype) {
+    return false;
+  }
+  const dex::TypeList* params = dex_file.GetProtoParameters(proto_id);
+  uint32_t number_of_params = (params == nullptr) ? 0u : params->Size();
+  if (number_of_params != number_of_ptypes) {
+    return false;
+  }
+  for (uint32_t i = 0; i != number_of_params; ++i) {
+    ObjPtr<mirror::Class> ptype = get_ptype(i);
+    if (ptype == nullptr ||
+        class_linker->LookupResolvedType(params->GetTypeItem(i).type_idx_, referrer) != ptype) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HInvoke* HInliner::TryReplaceMethodHandleInvokeExact(HInvokePolymorphic* invoke_instruction) {
+  ScopedObjectAccess soa(Thread::Current());
+  ArtMethod* referrer = graph_->GetArtMethod();
+  if (referrer == nullptr) {
+    return nullptr;
+  }
+  const DexFile& dex_file = *invoke_instruction->GetMethodReference().dex_file;
+  DCHECK(IsSameDexFile(dex_file, *referrer->GetDexFile()));
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  HInstruction* handle = invoke_instruction->InputAt(0);
+
+  ArtMethod* target = nullptr;
+  bool is_static = false;
+  MethodReference target_reference(nullptr, 0u);
+  if (handle->IsLoadMethodHandle()) {
+    // Decode the `const-method-handle` from the dex file rather than resolving it, so that
+    // no method handle or method type object is created at compile time.
+    HLoadMethodHandle* load = handle->AsLoadMethodHandle();
+    DCHECK(IsSameDexFile(load->GetDexFile(), dex_file));
+    const dex::MethodHandleItem& item = dex_file.GetMethodHandle(load->GetMethodHandleIndex());
+    DexFile::MethodHandleType handle_type =
+        static_cast<DexFile::MethodHandleType>(item.method_handle_type_);
+    if (handle_type != DexFile::MethodHandleType::kInvokeStatic &&
+        handle_type != DexFile::MethodHandleType::kInvokeInstance &&
+        handle_type != DexFile::MethodHandleType::kInvokeDirect) {
+      return nullptr;
+    }
+    uint32_t method_idx = item.field_or_method_idx_;
+    target = class_linker->LookupResolvedMethod(
+        method_idx, referrer->GetDexCache(), referrer->GetClassLoader());
+    is_static = (handle_type == DexFile::MethodHandleType::kInvokeStatic);
+    if (target == nullptr ||
+        target->IsStatic() != is_static ||
+        // An invoke-direct handle on a non-private method is an invoke-super.
+        (handle_type == DexFile::MethodHandleType::kInvokeDirect && !target->IsPrivate()) ||
+        !referrer->GetDeclaringClass()->CanAccessMember(target->GetDeclaringClass(),
+                                                         target->GetAccessFlags())) {
+      return nullptr;
+    }
+    // The handle type is the method type, with the class named in the method id as the
+    // receiver for instance methods.
+    const dex::MethodId& method_id = dex_file.GetMethodId(method_idx);
+    const dex::ProtoId& target_proto = dex_file.GetProtoId(method_id.proto_idx_);
+    const dex::TypeList* target_params = dex_file.GetProtoParameters(target_proto);
+    uint32_t number_of_receivers = is_static ? 0u : 1u;
+    uint32_t number_of_ptypes =
+        number_of_receivers + ((target_params == nullptr) ? 0u : target_params->Size());
+    auto get_ptype = [&](uint32_t i) REQUIRES_SHARED(Locks::mutator_lock_) {
+      dex::TypeIndex type_idx = (i < number_of_receivers)
+          ? method_id.class_idx_
+          : target_params->GetTypeItem(i - number_of_receivers).type_idx_;
+      return class_linker->LookupResolvedType(type_idx, referrer);
+    };
+    if (!CallSiteTypeMatches(invoke_instruction,
+                             referrer,
+                             number_of_ptypes,
+                             get_ptype,
+                             class_linker->LookupResolvedType(target_proto.return_type_idx_,
+                                                              referrer))) {
+      return nullptr;
+    }
+    target_reference = MethodReference(&dex_file, method_idx);
+  } else if (handle->IsStaticFieldGet() && codegen_->GetCompilerOptions().IsJitCompiler()) {
+    // A static final field of an initialized class cannot change anymore, so the JIT can
+    // use the method handle it holds.
+    ArtField* field = handle->AsStaticFieldGet()->GetFieldInfo().GetField();
+    if (field == nullptr ||
+        !field->IsFinal() ||
+        !field->GetDeclaringClass()->IsVisiblyInitialized()) {
+      return nullptr;
+    }
+    ObjPtr<mirror::Object> value = field->GetObject(field->GetDeclaringClass());
+    if (value == nullptr ||
+        !value->InstanceOf(GetClassRoot<mirror::MethodHandle>(class_linker))) {
+      return nullptr;
+    }
+    ObjPtr<mirror::MethodHandle> method_handle = ObjPtr<mirror::MethodHandle>::DownCast(value);
+    // A handle returned by `asType()` has a nominal type that `invokeExact()` must match
+    // instead of the handle type, and it may need argument conversions.
+    if (method_handle->GetNominalType() != nullptr) {
+      return nullptr;
+    }
+    mirror::MethodHandle::Kind kind = method_handle->GetHandleKind();
+    if (kind != mirror::MethodHandle::Kind::kInvokeStatic &&
+        kind != mirror::MethodHandle::Kind::kInvokeVirtual &&
+        kind != mirror::MethodHandle::Kind::kInvokeDirect) {
+      return nullptr;
+    }
+    target = method_handle->GetTargetMethod();
+    is_static = (kind == mirror::MethodHandle::Kind::kInvokeStatic);
+    if (target->IsStatic() != is_static ||
+        (kind == mirror::MethodHandle::Kind::kInvokeDirect && !target->IsPrivate())) {
+      return nullptr;
+    }
+    ObjPtr<mirror::MethodType> method_type = method_handle->GetMethodType();
+    ObjPtr<mirror::ObjectArray<mirror::Class>> ptypes = method_type->GetPTypes();
+    auto get_ptype = [&](uint32_t i) REQUIRES_SHARED(Locks::mutator_lock_) {
+      return ptypes->Get(i);
+    };
+    if (!CallSiteTypeMatches(invoke_instruction,
+                             referrer,
+                             ptypes->GetLength(),
+                             get_ptype,
+                             method_type->GetRType())) {
+      return nullptr;
+    }
+    target_reference = MethodReference(target->GetDexFile(), target->GetDexMethodIndex());
+  } else {
+    return nullptr;
+  }
+
+  if (target->IsConstructor() ||
+      target->IsProxyMethod() ||
+      target->GetDeclaringClass()->IsInterface()) {
+    return nullptr;
+  }
+
+  // Dispatch on the receiver only if the target may be overridden.
+  bool is_virtual =
+      !is_static && !target->IsPrivate() && !IsMethodOrDeclaringClassFinal(target);
+  HInvoke* new_invoke = nullptr;
+  ArenaAllocator* allocator = graph_->GetAllocator();
+  uint32_t dex_pc = invoke_instruction->GetDexPc();
+  uint32_t number_of_arguments = invoke_instruction->GetNumberOfArguments() - 1u;
+  if (is_virtual) {
+    new_invoke = new (allocator) HInvokeVirtual(allocator,
+                                                number_of_arguments,
+                                                invoke_instruction->GetType(),
+                                                dex_pc,
+                                                target_reference,
+                                                target,
+                                                target_reference,
+                                                target->GetMethodIndex());
+  } else {
+    HInvokeStaticOrDirect::DispatchInfo dispatch_info =
+        HSharpening::SharpenLoadMethod(target,
+                                       /* has_method_id= */ IsSameDexFile(
+                                           *target_reference.dex_file, dex_file),
+                                       /* for_interface_call= */ false,
+                                       codegen_);
+    // Only use an ArtMethod* known at compile time. A runtime call resolves the method
+    // index in the caller's dex file, and a .bss entry is filled by the resolution trampoline
+    // which decodes the invoke at the dex pc; both would see the `invoke-polymorphic` there.
+    if (dispatch_info.method_load_kind != MethodLoadKind::kRecursive &&
+        dispatch_info.method_load_kind != MethodLoadKind::kBootImageLinkTimePcRelative &&
+        dispatch_info.method_load_kind != MethodLoadKind::kBootImageRelRo &&
+        dispatch_info.method_load_kind != MethodLoadKind::kJitDirectAddress) {
+      return nullptr;
+    }
+    if (dispatch_info.code_ptr_location == CodePtrLocation::kCallCriticalNative) {
+      // The @CriticalNative calling convention needs the argument fixups of the builder.
+      return nullptr;
+    }
+    // A static target in a class that is not initialized yet is called through the
+    // resolution stub, which initializes the class.
+    HInvokeStaticOrDirect::ClinitCheckRequirement clinit_check_requirement =
+        (!is_static || target->GetDeclaringClass()->IsVisiblyInitialized())
+            ? HInvokeStaticOrDirect::ClinitCheckRequirement::kNone
+            : HInvokeStaticOrDirect::ClinitCheckRequirement::kImplicit;
+    HInvokeStaticOrDirect* invoke = new (allocator) HInvokeStaticOrDirect(
+        allocator,
+        number_of_arguments,
+        invoke_instruction->GetType(),
+        dex_pc,
+        target_reference,
+        target,
+        dispatch_info,
+        is_static ? kStatic : kDirect,
+        target_reference,
+        clinit_check_requirement);
+    if (HInvokeStaticOrDirect::NeedsCurrentMethodInput(dispatch_info)) {
+      invoke->SetRawInputAt(invoke->GetCurrentMethodIndexUnchecked(), graph_->GetCurrentMethod());
+    }
+    new_invoke = invoke;
+  }
+
+  HBasicBlock* block = invoke_instruction->GetBlock();
+  for (uint32_t index = 0; index != number_of_arguments; ++index) {
+    HInstruction* argument = invoke_instruction->InputAt(index + 1u);
+    if (index == 0u && !is_static) {
+      // `invokeExact()` throws NullPointerException for a null receiver.
+      HNullCheck* null_check = new (allocator) HNullCheck(argument, dex_pc);
+      block->InsertInstructionBefore(null_check, invoke_instruction);
+      null_check->CopyEnvironmentFrom(invoke_instruction->GetEnvironment());
+      null_check->SetReferenceTypeInfo(argument->GetReferenceTypeInfo());
+      argument = null_check;
+    }
+    new_invoke->SetArgumentAt(index, argument);
+  }
+  block->InsertInstructionBefore(new_invoke, invoke_instruction);
+  new_invoke->CopyEnvironmentFrom(invoke_instruction->GetEnvironment());
+  if (invoke_instruction->GetType() == DataType::Type::kReference) {
+    new_invoke->SetReferenceTypeInfo(invoke_instruction->GetReferenceTypeInfo());
+  }
+  MaybeReplaceAndRemove(new_invoke, invoke_instruction);
+  MaybeRecordStat(stats_, MethodCompilationStat::kDevirtualizedMethodHandleInvokeExact);
+  return new_invoke;
+}
+
 bool HInliner::TryInlineAndReplace(HInvoke* invoke_instruction,
                                    ArtMethod* method,
                                    ReferenceTypeInfo receiver_type,
@@ -1378,9 +1624,61 @@ bool HInliner::IsInliningSupported(const HInvoke* invoke_instruction,
   return true;
 }
 
+HInliner::CallSiteHotness HInliner::GetCallSiteHotness(HInvoke* invoke_instruction,
+                                                      ArtMethod* method) const {
+  Runtime* runtime = Runtime::Current();
+  if (runtime->IsAotCompiler() || runtime->IsZygote()) {
+    const ProfileCompilationInfo* pci =
+        codegen_->GetCompilerOptions().GetProfileCompilationInfo();
+    if (pci == nullptr ||
+        pci->FindDexFile(*method->GetDexFile()) == ProfileCompilationInfo::MaxProfileIndex()) {
+      return CallSiteHotness::kUnknown;
+    }
+    ProfileCompilationInfo::MethodHotness hotness = pci->GetMethodHotness(
+        MethodReference(method->GetDexFile(), method->GetDexMethodIndex()));
+    if (hotness.IsHot()) {
+      return CallSiteHotness::kHot;
+    }
+    // A method missing from the profile may just not have been profiled. Only a method that
+    // the profile shows was executed during startup but not after it is cold.
+    if (hotness.IsStartup() && !hotness.IsPostStartup()) {
+      return CallSiteHotness::kCold;
+    }
+    return CallSiteHotness::kUnknown;
+  }
+
+  if (!codegen_->GetCompilerOptions().IsJitCompiler()) {
+    return CallSiteHotness::kUnknown;
+  }
+  jit::Jit* jit = runtime->GetJit();
+  Thread* self = Thread::Current();
+  {
+    // Virtual and interface calls have an inline cache, which is only filled when the
+    // call site gets executed.
+    ScopedProfilingInfoUse spiu(jit, graph_->GetArtMethod(), self);
+    ProfilingInfo* profiling_info = spiu.GetProfilingInfo();
+    InlineCache* cache = (profiling_info != nullptr)
+        ? profiling_info->FindInlineCache(invoke_instruction->GetDexPc())
+        : nullptr;
+    if (cache != nullptr) {
+      StackHandleScope<InlineCache::kIndividualCacheSize> classes(self);
+      jit->GetCodeCache()->CopyInlineCacheInto(*cache, &classes);
+      return (GetInlineCacheType(classes) == kInlineCacheUninitialized)
+          ? CallSiteHotness::kCold
+          : CallSiteHotness::kHot;
+    }
+  }
+  // Otherwise, a callee that got warm enough to be profiled is considered hot.
+  ScopedProfilingInfoUse callee_spiu(jit, method, self);
+  return (callee_spiu.GetProfilingInfo() != nullptr)
+      ? CallSiteHotness::kHot
+      : CallSiteHotness::kUnknown;
+}
+
 // Returns whether our resource limits allow inlining this method.
 bool HInliner::IsInliningBudgetAvailable(ArtMethod* method,
-                                         const CodeItemDataAccessor& accessor) const {
+                                         const CodeItemDataAccessor& accessor,
+                                         CallSiteHotness hotness) const {
   if (CountRecursiveCallsOf(method) > kMaximumNumberOfRecursiveCalls) {
     LOG_FAIL(stats_, MethodCompilationStat::kNotInlinedRecursiveBudget)
         << "Method "
@@ -1390,6 +1688,21 @@ bool HInliner::IsInliningBudgetAvailable(ArtMethod* method,
   }
 
   size_t inline_max_code_units = codegen_->GetCompilerOptions().GetInlineMaxCodeUnits();
+  if (hotness == CallSiteHotness::kHot) {
+    inline_max_code_units *= kHotCallSiteCodeUnitsMultiplier;
+  } else if (hotness == CallSiteHotness::kCold) {
+    size_t cold_max_code_units = inline_max_code_units / kColdCallSiteCodeUnitsDivisor;
+    if (accessor.InsnsSizeInCodeUnits() > cold_max_code_units &&
+        accessor.InsnsSizeInCodeUnits() <= inline_max_code_units) {
+      LOG_FAIL(stats_, MethodCompilationStat::kNotInlinedColdCallSite)
+          << "Method " << method->PrettyMethod()
+          << " is not inlined because the call site is cold and its code item is too big: "
+          << accessor.InsnsSizeInCodeUnits()
+          << " > "
+          << cold_max_code_units;
+      return false;
+    }
+  }
   if (accessor.InsnsSizeInCodeUnits() > inline_max_code_units) {
     LOG_FAIL(stats_, MethodCompilationStat::kNotInlinedCodeItem)
         << "Method " << method->PrettyMethod()
@@ -1465,7 +1778,8 @@ bool HInliner::TryBuildAndInline(HInvoke* invoke_instruction,
     return false;
   }
 
-  if (!IsInliningBudgetAvailable(method, accessor)) {
+  CallSiteHotness hotness = GetCallSiteHotness(invoke_instruction, method);
+  if (!IsInliningBudgetAvailable(method, accessor, hotness)) {
     return false;
   }
 
@@ -1476,6 +1790,9 @@ bool HInliner::TryBuildAndInline(HInvoke* invoke_instruction,
 
   LOG_SUCCESS() << method->PrettyMethod();
   MaybeRecordStat(stats_, MethodCompilationStat::kInlinedInvoke);
+  if (hotness == CallSiteHotness::kHot) {
+    MaybeRecordStat(stats_, MethodCompilationStat::kInlinedHotCallSite);
+  }
   return true;
 }
 
@@ -70,6 +70,13 @@ class HInliner : public HOptimization {
     kInlineCacheMissingTypes = 5
   };
 
+  // How often a call site is executed, according to the JIT inline caches or the AOT profile.
+  enum class CallSiteHotness {
+    kUnknown,
+    kCold,
+    kHot,
+  };
+
   bool TryInline(HInvoke* invoke_instruction);
 
   // Try to inline `resolved_method` in place of `invoke_instruction`. `do_rtp` is whether
@@ -130,8 +137,15 @@ class HInliner : public HOptimization {
   // Returns whether the inlining budget allows inlining method.
   //
   // For example, this checks whether the function has grown too large and
-  // inlining should be prevented.
-  bool IsInliningBudgetAvailable(art::ArtMethod* method, const CodeItemDataAccessor& accessor) const
+  // inlining should be prevented. Hot call sites get a larger code item limit,
+  // cold ones a smaller one.
+  bool IsInliningBudgetAvailable(art::ArtMethod* method,
+                                 const CodeItemDataAccessor& accessor,
+                                 CallSiteHotness hotness) const
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns how hot the call site `invoke_instruction` targeting `method` is.
+  CallSiteHotness GetCallSiteHotness(HInvoke* invoke_instruction, ArtMethod* method) const
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Inspects the body of a method (callee_graph) and returns whether it can be
@@ -163,6 +177,12 @@ class HInliner : public HOptimization {
   bool TryInlineFromCHA(HInvoke* invoke_instruction)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Try to replace `MethodHandle.invokeExact()` on a constant method handle (a
+  // `const-method-handle`, or a static final field when JIT compiling) by a call to the
+  // handle's target. Returns the new invoke, or nullptr if the handle or its type is not
+  // known exactly at compile time.
+  HInvoke* TryReplaceMethodHandleInvokeExact(HInvokePolymorphic* invoke_instruction);
+
   // When we fail inlining `invoke_instruction`, we will try to devirtualize the
   // call.
   bool TryDevirtualize(HInvoke* invoke_instruction,
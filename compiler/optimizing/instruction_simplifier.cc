@@ -74,6 +74,7 @@ class InstructionSimplifierVisitor : public HGraphDelegateVisitor {
   void VisitEqual(HEqual* equal) override;
   void VisitNotEqual(HNotEqual* equal) override;
   void VisitBooleanNot(HBooleanNot* bool_not) override;
+  void VisitInstanceFieldGet(HInstanceFieldGet* instruction) override;
   void VisitInstanceFieldSet(HInstanceFieldSet* equal) override;
   void VisitStaticFieldSet(HStaticFieldSet* equal) override;
   void VisitArraySet(HArraySet* equal) override;
@@ -943,6 +944,34 @@ static HInstruction* AllowInMinMax(IfCondition cmp,
   return nullptr;
 }
 
+void InstructionSimplifierVisitor::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  // Scalar replacement of a boxed int: `Integer.valueOf(x).value` is `x`. The allocation
+  // itself is left to LSE, which keeps the environment uses correct for deoptimization.
+  HInstruction* object = instruction->InputAt(0);
+  if (object->IsNullCheck()) {
+    object = object->InputAt(0);
+  }
+  if (!object->IsInvoke() ||
+      object->AsInvoke()->GetIntrinsic() != Intrinsics::kIntegerValueOf ||
+      instruction->GetFieldType() != DataType::Type::kInt32 ||
+      instruction->IsVolatile()) {
+    return;
+  }
+  HInvoke* value_of = object->AsInvoke();
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    ObjPtr<mirror::Class> integer_class = value_of->GetResolvedMethod()->GetDeclaringClass();
+    ArtField* value_field = integer_class->FindDeclaredInstanceField("value", "I");
+    DCHECK(value_field != nullptr);
+    if (instruction->GetFieldInfo().GetField() != value_field) {
+      return;
+    }
+  }
+  instruction->ReplaceWith(value_of->InputAt(0));
+  instruction->GetBlock()->RemoveInstruction(instruction);
+  RecordSimplification();
+}
+
 // TODO This should really be done by LSE itself since there is significantly
 // more information available there.
 void InstructionSimplifierVisitor::VisitPredicatedInstanceFieldGet(
@@ -2556,6 +2585,17 @@ static bool NoEscapeForStringBufferReference(HInstruction* reference, HInstructi
   return false;
 }
 
+static bool IsEmptyStringConstant(HInstruction* instruction) {
+  if (!instruction->IsLoadString()) {
+    return false;
+  }
+  HLoadString* load_string = instruction->AsLoadString();
+  uint32_t utf16_length;
+  load_string->GetDexFile().StringDataAndUtf16LengthByIdx(load_string->GetStringIndex(),
+                                                          &utf16_length);
+  return utf16_length == 0u;
+}
+
 static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
   DCHECK_EQ(invoke->GetIntrinsic(), Intrinsics::kStringBuilderToString);
   if (invoke->CanThrowIntoCatchBlock()) {
@@ -2584,8 +2624,10 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
   }
 
   // Collect args and check for unexpected uses.
-  // We expect one call to a constructor with no arguments, one constructor fence (unless
-  // eliminated), some number of append calls and one call to StringBuilder.toString().
+  // We expect one call to a constructor, one constructor fence (unless eliminated), some
+  // number of append calls and one call to StringBuilder.toString(). The constructor may
+  // take a constant initial capacity, which is irrelevant for the fused append, or a
+  // constant string, which becomes the first argument.
   bool seen_constructor = false;
   bool seen_constructor_fence = false;
   bool seen_to_string = false;
@@ -2666,6 +2708,11 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
       // Uses of the append return value should have been replaced with the first input.
       DCHECK(!as_invoke_virtual->HasUses());
       DCHECK(!as_invoke_virtual->HasEnvironmentUses());
+      // Appending a constant empty string is a no-op, fold it away.
+      if (arg == StringBuilderAppend::Argument::kString &&
+          IsEmptyStringConstant(as_invoke_virtual->InputAt(1u))) {
+        continue;
+      }
       if (num_args == StringBuilderAppend::kMaxArgs) {
         return false;
       }
@@ -2674,12 +2721,37 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
       ++num_args;
     } else if (user->IsInvokeStaticOrDirect() &&
                user->AsInvokeStaticOrDirect()->GetResolvedMethod() != nullptr &&
-               user->AsInvokeStaticOrDirect()->GetResolvedMethod()->IsConstructor() &&
-               user->AsInvokeStaticOrDirect()->GetNumberOfArguments() == 1u) {
+               user->AsInvokeStaticOrDirect()->GetResolvedMethod()->IsConstructor()) {
       // After arguments, we should see the constructor.
-      // We accept only the constructor with no extra arguments.
       DCHECK(!seen_constructor);
       DCHECK(!seen_constructor_fence);
+      HInvokeStaticOrDirect* constructor = user->AsInvokeStaticOrDirect();
+      if (constructor->GetNumberOfArguments() == 2u) {
+        // StringBuilder(int), StringBuilder(String) or StringBuilder(CharSequence).
+        HInstruction* constructor_arg = constructor->InputAt(1u);
+        if (constructor_arg->GetType() == DataType::Type::kInt32) {
+          // A negative capacity would throw NegativeArraySizeException.
+          if (!constructor_arg->IsIntConstant() ||
+              constructor_arg->AsIntConstant()->GetValue() < 0) {
+            return false;
+          }
+        } else if (constructor_arg->IsLoadString()) {
+          // A constant string cannot be null, so the constructor cannot throw.
+          if (!IsEmptyStringConstant(constructor_arg)) {
+            if (num_args == StringBuilderAppend::kMaxArgs) {
+              return false;
+            }
+            format = (format << StringBuilderAppend::kBitsPerArg) |
+                     static_cast<uint32_t>(StringBuilderAppend::Argument::kString);
+            args[num_args] = constructor_arg;
+            ++num_args;
+          }
+        } else {
+          return false;
+        }
+      } else if (constructor->GetNumberOfArguments() != 1u) {
+        return false;
+      }
       seen_constructor = true;
     } else if (user->IsConstructorFence()) {
       // The last use we see is the constructor fence.
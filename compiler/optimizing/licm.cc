@@ -16,6 +16,9 @@
 
 #include "licm.h"
 
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "load_store_analysis.h"
 #include "side_effects_analysis.h"
 
 namespace art {
@@ -78,6 +81,58 @@ static void UpdateLoopPhisIn(HEnvironment* environment, HLoopInformation* info)
   }
 }
 
+/**
+ * Returns whether `instruction` is a heap load that LSA keeps track of.
+ */
+static bool IsTrackedHeapLoad(HInstruction* instruction) {
+  return instruction->IsInstanceFieldGet() ||
+         instruction->IsStaticFieldGet() ||
+         instruction->IsArrayGet();
+}
+
+/**
+ * Returns the LSA heap location accessed by the tracked load or store `instruction`.
+ */
+static size_t GetHeapLocation(const HeapLocationCollector& heap_location_collector,
+                              HInstruction* instruction) {
+  if (instruction->IsInstanceFieldGet() || instruction->IsInstanceFieldSet() ||
+      instruction->IsStaticFieldGet() || instruction->IsStaticFieldSet()) {
+    return heap_location_collector.GetFieldHeapLocation(instruction->InputAt(0),
+                                                        &instruction->GetFieldInfo());
+  }
+  DCHECK(instruction->IsArrayGet() || instruction->IsArraySet() || instruction->IsVecStore());
+  return heap_location_collector.GetArrayHeapLocation(instruction);
+}
+
+/**
+ * Collects the heap locations written in the loop `info` into `stores`. Returns false
+ * if the loop contains a write that LSA does not track, such as an invoke.
+ */
+static bool CollectLoopStores(const HeapLocationCollector& heap_location_collector,
+                              HLoopInformation* info,
+                              ScopedArenaVector<size_t>* stores) {
+  for (HBlocksInLoopIterator it_loop(*info); !it_loop.Done(); it_loop.Advance()) {
+    for (HInstructionIterator it(it_loop.Current()->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (!instruction->DoesAnyWrite()) {
+        continue;
+      }
+      if (!instruction->IsInstanceFieldSet() &&
+          !instruction->IsStaticFieldSet() &&
+          !instruction->IsArraySet() &&
+          !instruction->IsVecStore()) {
+        return false;
+      }
+      size_t location = GetHeapLocation(heap_location_collector, instruction);
+      if (location == HeapLocationCollector::kHeapLocationNotFound) {
+        return false;
+      }
+      stores->push_back(location);
+    }
+  }
+  return true;
+}
+
 bool LICM::Run() {
   bool didLICM = false;
   DCHECK(side_effects_.HasRun());
@@ -91,6 +146,14 @@ bool LICM::Run() {
                                                           kArenaAllocLICM);
   }
 
+  // Alias information used to hoist heap loads that the loop side effects alone would
+  // keep in the loop. Computed lazily, on the first such load.
+  ScopedArenaAllocator allocator(graph_->GetArenaStack());
+  LoadStoreAnalysis lsa(graph_, /* stats= */ nullptr, &allocator, LoadStoreAnalysisType::kBasic);
+  bool lsa_has_run = false;
+  bool lsa_succeeded = false;
+  ScopedArenaVector<size_t> loop_stores(allocator.Adapter(kArenaAllocLICM));
+
   // Post order visit to visit inner loops before outer loops.
   for (HBasicBlock* block : graph_->GetPostOrder()) {
     if (!block->IsLoopHeader()) {
@@ -101,6 +164,42 @@ bool LICM::Run() {
     HLoopInformation* loop_info = block->GetLoopInformation();
     SideEffects loop_effects = side_effects_.GetLoopEffects(block);
     HBasicBlock* pre_header = loop_info->GetPreHeader();
+    // Whether `loop_stores` holds the stores of this loop, and whether all writes in
+    // the loop are stores known to LSA.
+    bool loop_stores_collected = false;
+    bool loop_stores_are_tracked = false;
+    loop_stores.clear();
+
+    // Returns whether the heap load `load` cannot observe any store in the loop.
+    auto is_unaliased_by_loop_stores = [&](HInstruction* load) {
+      if (!lsa_has_run) {
+        lsa_has_run = true;
+        lsa_succeeded = lsa.Run();
+      }
+      if (!lsa_succeeded) {
+        return false;
+      }
+      const HeapLocationCollector& heap_location_collector = lsa.GetHeapLocationCollector();
+      if (!loop_stores_collected) {
+        loop_stores_collected = true;
+        loop_stores_are_tracked =
+            CollectLoopStores(heap_location_collector, loop_info, &loop_stores);
+      }
+      if (!loop_stores_are_tracked) {
+        return false;
+      }
+      size_t load_location = GetHeapLocation(heap_location_collector, load);
+      if (load_location == HeapLocationCollector::kHeapLocationNotFound) {
+        return false;
+      }
+      return std::none_of(loop_stores.begin(),
+                          loop_stores.end(),
+                          [&](size_t store_location) {
+                            return store_location == load_location ||
+                                   heap_location_collector.MayAlias(load_location,
+                                                                    store_location);
+                          });
+    };
 
     for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
       HBasicBlock* inner = it_loop.Current();
@@ -146,6 +245,13 @@ bool LICM::Run() {
             }
           } else if (!instruction->GetSideEffects().MayDependOn(loop_effects)) {
             can_move = true;
+          } else if (IsTrackedHeapLoad(instruction) &&
+                     !instruction->GetSideEffects().MayDependOn(
+                         loop_effects.Exclusion(SideEffects::AllWrites())) &&
+                     is_unaliased_by_loop_stores(instruction)) {
+            // The loop writes the heap, but none of its stores may write what
+            // `instruction` reads.
+            can_move = true;
           }
         }
         if (can_move) {
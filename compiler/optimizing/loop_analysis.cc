@@ -423,4 +423,19 @@ ArchNoOptsLoopHelper* ArchNoOptsLoopHelper::Create(const CodeGenerator& codegen,
   }
 }
 
+bool ArchNoOptsLoopHelper::IsLoopPeelingEnabledFor(const CodeGenerator& codegen) {
+  InstructionSet isa = codegen.GetInstructionSet();
+  switch (isa) {
+    case InstructionSet::kArm64: {
+      return Arm64LoopHelper(codegen).IsLoopPeelingEnabled();
+    }
+    case InstructionSet::kX86_64: {
+      return X86_64LoopHelper(codegen).IsLoopPeelingEnabled();
+    }
+    default: {
+      return ArchDefaultLoopHelper(codegen).IsLoopPeelingEnabled();
+    }
+  }
+}
+
 }  // namespace art
@@ -140,6 +140,10 @@ class ArchNoOptsLoopHelper : public ArenaObject<kArenaAllocOptimization> {
   // doesn't support loop peeling and unrolling.
   static ArchNoOptsLoopHelper* Create(const CodeGenerator& codegen, ArenaAllocator* allocator);
 
+  // Returns whether the helper created for the target enables scalar loop peeling, without
+  // allocating it.
+  static bool IsLoopPeelingEnabledFor(const CodeGenerator& codegen);
+
   // Returns whether the loop is not beneficial for loop peeling/unrolling.
   //
   // For example, if the loop body has too many instructions then peeling/unrolling optimization
@@ -436,6 +436,29 @@ static void PeelByCount(HLoopInformation* loop_info,
   }
 }
 
+// Returns whether the index is compared in the loop header condition, in which case a runtime
+// test on its range also ensures that the loop is finite.
+static bool IsLoopControlIndex(HLoopInformation* loop_info, HInstruction* index) {
+  HInstruction* control = loop_info->GetHeader()->GetLastInstruction();
+  if (control->IsIf() && control->InputAt(0)->IsCondition()) {
+    HCondition* condition = control->InputAt(0)->AsCondition();
+    return index == condition->InputAt(0) || index == condition->InputAt(1);
+  }
+  return false;
+}
+
+// Returns the loop invariant array of an array length inside the loop, or nullptr.
+static HInstruction* GetInvariantArrayOfLength(HLoopInformation* loop_info, HInstruction* length) {
+  if (!length->IsArrayLength()) {
+    return nullptr;
+  }
+  HInstruction* array = length->InputAt(0);
+  if (!loop_info->IsDefinedOutOfTheLoop(array) && array->IsNullCheck()) {
+    array = array->InputAt(0);
+  }
+  return loop_info->IsDefinedOutOfTheLoop(array) ? array : nullptr;
+}
+
 // Returns the narrower type out of instructions a and b types.
 static DataType::Type GetNarrowerType(HInstruction* a, HInstruction* b) {
   DataType::Type type = a->GetType();
@@ -779,7 +802,12 @@ bool HLoopOptimization::TryOptimizeInnerLoopFinite(LoopNode* node) {
 }
 
 bool HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
-  return TryOptimizeInnerLoopFinite(node) || TryPeelingAndUnrolling(node);
+  // Versioning for bounds checks goes first, as a loop with bounds checks cannot be vectorized
+  // and the versioned loop is optimized further when the checks are removed.
+  return TryVersioningForBoundsChecks(node) ||
+         TryOptimizeInnerLoopFinite(node) ||
+         TryLoopUnswitching(node) ||
+         TryPeelingAndUnrolling(node);
 }
 
 
@@ -912,6 +940,221 @@ bool HLoopOptimization::TryPeelingAndUnrolling(LoopNode* node) {
          TryUnrollingForBranchPenaltyReduction(&analysis_info);
 }
 
+//
+// Loop versioning and unswitching.
+//
+
+bool HLoopOptimization::IsLoopVersioningEnabled(const CompilerOptions& compiler_options,
+                                                const HGraph* graph,
+                                                bool is_loop_peeling_enabled) {
+  // An OSR entry into a loop would skip the runtime test that selects the loop version.
+  return compiler_options.LoopVersioning() &&
+         is_loop_peeling_enabled &&
+         !graph->IsCompilingOsr();
+}
+
+// Returns whether the bounds check has a range that can be tested before the loop.
+static bool IsVersionableBoundsCheck(HLoopInformation* loop_info,
+                                     HBoundsCheck* bounds_check,
+                                     InductionVarRange* induction_range) {
+  HInstruction* index = bounds_check->InputAt(0);
+  HInstruction* length = bounds_check->InputAt(1);
+  if (!loop_info->IsDefinedOutOfTheLoop(length) &&
+      GetInvariantArrayOfLength(loop_info, length) == nullptr) {
+    return false;
+  }
+  // A taken-test is not needed: the range test may fail for a loop that is not entered at all,
+  // which then simply runs the checked copy. A loop that may be infinite would overshoot the
+  // range evaluation, unless the range test is on the loop control index itself, which then
+  // bounds the loop.
+  bool needs_finite_test = false;
+  bool needs_taken_test = false;
+  return induction_range->CanGenerateRange(
+             bounds_check, index, &needs_finite_test, &needs_taken_test) &&
+         (!needs_finite_test || IsLoopControlIndex(loop_info, index));
+}
+
+bool HLoopOptimization::CanVersionForBoundsCheck(const HGraph* graph,
+                                                 HBoundsCheck* bounds_check,
+                                                 InductionVarRange* induction_range) {
+  HLoopInformation* loop_info = bounds_check->GetBlock()->GetLoopInformation();
+  // Run() skips graphs with try/catch or irreducible loops. The size of the loop is not
+  // checked, as the loop of a check left by bounds check elimination is always versioned.
+  return loop_info != nullptr &&
+         !graph->HasTryCatch() &&
+         !graph->HasIrreducibleLoops() &&
+         LoopClonerHelper::IsLoopVersionable(loop_info, /*check_size=*/ false) &&
+         IsVersionableBoundsCheck(loop_info, bounds_check, induction_range);
+}
+
+bool HLoopOptimization::TryVersioningForBoundsChecks(LoopNode* node) {
+  if (!IsLoopVersioningEnabled()) {
+    return false;
+  }
+  HLoopInformation* loop_info = node->loop_info;
+
+  // Collect the bounds checks with a range that can be tested before the loop, and all null
+  // checks on loop invariant references. The bounds checks use the same test as bounds check
+  // elimination (see CanVersionForBoundsCheck()), so that all the checks it left are removed.
+  ScopedArenaVector<HBoundsCheck*> bounds_checks(
+      loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<HNullCheck*> null_checks(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    for (HInstructionIterator it(it_loop.Current()->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (instruction->IsNullCheck()) {
+        if (loop_info->IsDefinedOutOfTheLoop(instruction->InputAt(0))) {
+          null_checks.push_back(instruction->AsNullCheck());
+        }
+      } else if (instruction->IsBoundsCheck() &&
+                 IsVersionableBoundsCheck(
+                     loop_info, instruction->AsBoundsCheck(), &induction_range_)) {
+        bounds_checks.push_back(instruction->AsBoundsCheck());
+      }
+    }
+  }
+  // A loop with checks left by bounds check elimination is versioned whatever its size, as
+  // these checks are not removed otherwise.
+  if (bounds_checks.empty() ||
+      !LoopClonerHelper::IsLoopVersionable(
+          loop_info, /*check_size=*/ !loop_info->HasBoundsChecksLeftToVersioning())) {
+    return false;
+  }
+
+  // Generate the runtime test. Array lengths can only be loaded after the null tests, so in
+  // that case the range test is generated in a block guarded by the null tests:
+  //
+  //   if (a != null && ...) {
+  //     in_range = (lower <= upper && upper < a.length) && ...;   // unsigned
+  //   }
+  //   if (phi(in_range, false)) {
+  //     <loop without the checks>
+  //   } else {
+  //     <fully checked loop>
+  //   }
+  HBasicBlock* fork = loop_info->GetPreHeader();
+  HBasicBlock* test_block = fork;
+  if (!null_checks.empty()) {
+    graph_->TransformLoopHeaderForBCE(loop_info->GetHeader());
+    fork = loop_info->GetPreHeader();
+    HBasicBlock* if_block = fork->GetDominator();
+    test_block = if_block->GetSuccessors()[0];  // True successor.
+    HBasicBlock* false_block = if_block->GetSuccessors()[1];  // False successor.
+    test_block->AddInstruction(new (global_allocator_) HGoto());
+    false_block->AddInstruction(new (global_allocator_) HGoto());
+    fork->AddInstruction(new (global_allocator_) HGoto());
+    if_block->AddInstruction(new (global_allocator_) HGoto());  // placeholder
+    HInstruction* not_null = nullptr;
+    for (HNullCheck* null_check : null_checks) {
+      HInstruction* cond = Insert(if_block, new (global_allocator_) HNotEqual(
+          null_check->InputAt(0), graph_->GetNullConstant()));
+      not_null = (not_null == nullptr)
+          ? cond
+          : Insert(if_block, new (global_allocator_) HAnd(DataType::Type::kInt32, not_null, cond));
+    }
+    if_block->RemoveInstruction(if_block->GetLastInstruction());
+    if_block->AddInstruction(new (global_allocator_) HIf(not_null));
+  }
+  HInstruction* in_range = nullptr;
+  for (HBoundsCheck* bounds_check : bounds_checks) {
+    HInstruction* index = bounds_check->InputAt(0);
+    HInstruction* length = bounds_check->InputAt(1);
+    if (!loop_info->IsDefinedOutOfTheLoop(length)) {
+      length = Insert(test_block, new (global_allocator_) HArrayLength(
+          GetInvariantArrayOfLength(loop_info, length),
+          kNoDexPc,
+          length->AsArrayLength()->IsStringLength()));
+    }
+    HInstruction* lower = nullptr;
+    HInstruction* upper = nullptr;
+    induction_range_.GenerateRange(bounds_check, index, graph_, test_block, &lower, &upper);
+    HInstruction* cond = Insert(test_block, new (global_allocator_) HBelow(upper, length));
+    if (lower != nullptr) {
+      // Unit stride: lower would exceed upper for a negative lower bound or wrap-around.
+      HInstruction* ordered =
+          Insert(test_block, new (global_allocator_) HBelowOrEqual(lower, upper));
+      cond = Insert(test_block,
+                    new (global_allocator_) HAnd(DataType::Type::kInt32, ordered, cond));
+    }
+    in_range = (in_range == nullptr)
+        ? cond
+        : Insert(test_block, new (global_allocator_) HAnd(DataType::Type::kInt32, in_range, cond));
+  }
+  if (test_block != fork) {
+    HPhi* phi = new (global_allocator_) HPhi(global_allocator_,
+                                             kNoRegNumber,
+                                             0,
+                                             HPhi::ToPhiType(in_range->GetType()));
+    phi->AddInput(in_range);
+    phi->AddInput(graph_->GetIntConstant(0));
+    fork->AddPhi(phi);
+    in_range = phi;
+  }
+
+  // Version the loop. The original loop, which keeps its induction information, is taken when
+  // the test succeeds and loses its checks; the copy keeps all of them.
+  LoopClonerSimpleHelper helper(loop_info, &induction_range_);
+  helper.DoVersioning();
+  DCHECK_EQ(fork->GetSuccessors().size(), 2u);
+  fork->RemoveInstruction(fork->GetLastInstruction());
+  fork->AddInstruction(new (global_allocator_) HIf(in_range));
+  for (HBoundsCheck* bounds_check : bounds_checks) {
+    bounds_check->ReplaceWith(bounds_check->InputAt(0));
+    bounds_check->GetBlock()->RemoveInstruction(bounds_check);
+  }
+  for (HNullCheck* null_check : null_checks) {
+    null_check->ReplaceWith(null_check->InputAt(0));
+    null_check->GetBlock()->RemoveInstruction(null_check);
+  }
+  induction_range_.ReVisit(loop_info);
+  MaybeRecordStat(stats_, MethodCompilationStat::kLoopVersionedForBoundsChecks);
+
+  // The loop without checks may be vectorizable now.
+  TryOptimizeInnerLoopFinite(node);
+  return true;
+}
+
+bool HLoopOptimization::TryLoopUnswitching(LoopNode* node) {
+  if (!IsLoopVersioningEnabled()) {
+    return false;
+  }
+  HLoopInformation* loop_info = node->loop_info;
+
+  // Find a branch inside the loop on a loop invariant condition. Loop exits on such
+  // conditions are handled by peeling instead.
+  HInstruction* condition = nullptr;
+  for (HBlocksInLoopIterator it(*loop_info); !it.Done() && condition == nullptr; it.Advance()) {
+    HIf* hif = it.Current()->GetLastInstruction()->AsIf();
+    if (hif != nullptr &&
+        !hif->InputAt(0)->IsConstant() &&
+        loop_info->IsDefinedOutOfTheLoop(hif->InputAt(0)) &&
+        loop_info->Contains(*hif->IfTrueSuccessor()) &&
+        loop_info->Contains(*hif->IfFalseSuccessor())) {
+      condition = hif->InputAt(0);
+    }
+  }
+  if (condition == nullptr || !LoopClonerHelper::IsLoopVersionable(loop_info)) {
+    return false;
+  }
+
+  // Version the loop on the condition and specialize the original loop for the true outcome
+  // and the copy for the false one. Dead code elimination removes the untaken branches.
+  HBasicBlock* fork = loop_info->GetPreHeader();
+  LoopClonerSimpleHelper helper(loop_info, &induction_range_);
+  helper.DoVersioning();
+  DCHECK_EQ(fork->GetSuccessors().size(), 2u);
+  fork->RemoveInstruction(fork->GetLastInstruction());
+  fork->AddInstruction(new (global_allocator_) HIf(condition));
+  for (const auto& entry : *helper.GetInstructionMap()) {
+    if (entry.first->IsIf() && entry.first->InputAt(0) == condition) {
+      entry.first->ReplaceInput(graph_->GetIntConstant(1), 0u);
+      entry.second->ReplaceInput(graph_->GetIntConstant(0), 0u);
+    }
+  }
+  MaybeRecordStat(stats_, MethodCompilationStat::kLoopUnswitched);
+  return true;
+}
+
 //
 // Loop vectorization. The implementation is based on the book by Aart J.C. Bik:
 // "The Software Vectorization Handbook. Applying Multimedia Extensions for Maximum Performance."
@@ -1010,7 +1253,7 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
       uint32_t vote = (offset == 0)
           ? 0
           : ((desired_alignment - offset) >> DataType::SizeShift(i->type));
-      DCHECK_LT(vote, 16u);
+      DCHECK_LT(vote, desired_alignment);
       ++peeling_votes[vote];
     } else if (BaseAlignment() >= desired_alignment &&
                num_same_alignment > max_num_same_alignment) {
@@ -1679,20 +1922,25 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
     case InstructionSet::kX86:
     case InstructionSet::kX86_64:
       // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD).
+      // AVX2-enabled X86_64 devices use 256-bit SIMD, which adds byte multiplication
+      // and byte/short abs.
       if (features->AsX86InstructionSetFeatures()->HasSSE4_1()) {
+        bool is_avx2 = GetVectorSizeInBytes() == 32u;
+        uint32_t vector_length = GetVectorSizeInBytes() / DataType::Size(type);
         switch (type) {
           case DataType::Type::kBool:
           case DataType::Type::kUint8:
           case DataType::Type::kInt8:
-            *restrictions |= kNoMul |
-                             kNoDiv |
+            *restrictions |= kNoDiv |
                              kNoShift |
-                             kNoAbs |
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD |
                              kNoDotProd;
-            return TrySetVectorLength(type, 16);
+            if (!is_avx2) {
+              *restrictions |= kNoMul | kNoAbs;
+            }
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kUint16:
             *restrictions |= kNoDiv |
                              kNoAbs |
@@ -1700,26 +1948,28 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
                              kNoUnroundedHAdd |
                              kNoSAD |
                              kNoDotProd;
-            return TrySetVectorLength(type, 8);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt16:
             *restrictions |= kNoDiv |
-                             kNoAbs |
                              kNoSignedHAdd |
                              kNoUnroundedHAdd |
                              kNoSAD;
-            return TrySetVectorLength(type, 8);
+            if (!is_avx2) {
+              *restrictions |= kNoAbs;
+            }
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt32:
             *restrictions |= kNoDiv | kNoSAD;
-            return TrySetVectorLength(type, 4);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kInt64:
             *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD;
-            return TrySetVectorLength(type, 2);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat32:
             *restrictions |= kNoReduction;
-            return TrySetVectorLength(type, 4);
+            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat64:
             *restrictions |= kNoReduction;
-            return TrySetVectorLength(type, 2);
+            return TrySetVectorLength(type, vector_length);
           default:
             break;
         }  // switch type
@@ -45,6 +45,19 @@ class HLoopOptimization : public HOptimization {
 
   bool Run() override;
 
+  // Returns whether loops of the graph may be versioned, given the compiler options and
+  // whether the target enables loop peeling.
+  static bool IsLoopVersioningEnabled(const CompilerOptions& compiler_options,
+                                      const HGraph* graph,
+                                      bool is_loop_peeling_enabled);
+
+  // Returns whether the loop of the bounds check may be versioned into a copy without the
+  // bounds check. Bounds check elimination leaves such checks to this pass and marks their
+  // loop, which is then versioned regardless of its size (see TryVersioningForBoundsChecks()).
+  static bool CanVersionForBoundsCheck(const HGraph* graph,
+                                       HBoundsCheck* bounds_check,
+                                       InductionVarRange* induction_range);
+
   static constexpr const char* kLoopOptimizationPassName = "loop_optimization";
 
  private:
@@ -166,6 +179,22 @@ class HLoopOptimization : public HOptimization {
   // Tries to apply scalar loop peeling and unrolling.
   bool TryPeelingAndUnrolling(LoopNode* node);
 
+  // Tries to version the loop into a copy without bounds checks and null checks on loop
+  // invariant references, guarded by a runtime range test, and a fully checked fallback copy.
+  // Returns whether transformation happened.
+  bool TryVersioningForBoundsChecks(LoopNode* node);
+
+  // Tries to unswitch the loop on a loop invariant condition, i.e. to version the loop
+  // into copies specialized for either outcome of the condition. Returns whether
+  // transformation happened.
+  bool TryLoopUnswitching(LoopNode* node);
+
+  // Returns whether the loop may be versioned by the two methods above.
+  bool IsLoopVersioningEnabled() const {
+    return IsLoopVersioningEnabled(
+        *compiler_options_, graph_, arch_loop_helper_->IsLoopPeelingEnabled());
+  }
+
   //
   // Vectorization analysis and synthesis.
   //
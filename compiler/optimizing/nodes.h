@@ -897,6 +897,7 @@ class HLoopInformation : public ArenaObject<kArenaAllocLoopInfo> {
         suspend_check_(nullptr),
         irreducible_(false),
         contains_irreducible_loop_(false),
+        has_bounds_checks_left_to_versioning_(false),
         back_edges_(graph->GetAllocator()->Adapter(kArenaAllocLoopInfoBackEdges)),
         // Make bit vector growable, as the number of blocks may change.
         blocks_(graph->GetAllocator(),
@@ -909,6 +910,11 @@ class HLoopInformation : public ArenaObject<kArenaAllocLoopInfo> {
   bool IsIrreducible() const { return irreducible_; }
   bool ContainsIrreducibleLoop() const { return contains_irreducible_loop_; }
 
+  // Whether bounds check elimination left some bounds checks of this loop to be removed
+  // by loop versioning in HLoopOptimization.
+  bool HasBoundsChecksLeftToVersioning() const { return has_bounds_checks_left_to_versioning_; }
+  void SetHasBoundsChecksLeftToVersioning() { has_bounds_checks_left_to_versioning_ = true; }
+
   void Dump(std::ostream& os);
 
   HBasicBlock* GetHeader() const {
@@ -1005,6 +1011,7 @@ class HLoopInformation : public ArenaObject<kArenaAllocLoopInfo> {
   HSuspendCheck* suspend_check_;
   bool irreducible_;
   bool contains_irreducible_loop_;
+  bool has_bounds_checks_left_to_versioning_;
   ArenaVector<HBasicBlock*> back_edges_;
   ArenaBitVector blocks_;
 
@@ -4928,7 +4935,9 @@ class HInvokeStaticOrDirect final : public HInvoke {
   }
 
   bool CanBeNull() const override {
-    return GetType() == DataType::Type::kReference && !IsStringInit();
+    return GetType() == DataType::Type::kReference &&
+           !IsStringInit() &&
+           GetIntrinsic() != Intrinsics::kIntegerValueOf;
   }
 
   MethodLoadKind GetMethodLoadKind() const { return dispatch_info_.method_load_kind; }
@@ -6299,6 +6308,19 @@ class HPredicatedInstanceFieldGet final : public HExpression<2> {
   const FieldInfo field_info_;
 };
 
+enum class WriteBarrierKind {
+  // Emit the write barrier, skipping the card mark at runtime if the stored value is null.
+  kEmitWithNullCheck,
+  // Emit the write barrier without the null check. Used when the barrier also covers the card
+  // of other stores that were coalesced into it, as those stores may have stored non-null values.
+  kEmitNoNullCheck,
+  // Do not emit the write barrier; the object's card is covered by another store or the object
+  // was allocated with no GC point between the allocation and the store.
+  kDontEmit,
+  kLast = kDontEmit
+};
+std::ostream& operator<<(std::ostream& os, WriteBarrierKind rhs);
+
 class HInstanceFieldSet final : public HExpression<2> {
  public:
   HInstanceFieldSet(HInstruction* object,
@@ -6323,6 +6345,7 @@ class HInstanceFieldSet final : public HExpression<2> {
                     dex_file) {
     SetPackedFlag<kFlagValueCanBeNull>(true);
     SetPackedFlag<kFlagIsPredicatedSet>(false);
+    SetPackedField<WriteBarrierKindField>(WriteBarrierKind::kEmitWithNullCheck);
     SetRawInputAt(0, object);
     SetRawInputAt(1, value);
   }
@@ -6343,6 +6366,12 @@ class HInstanceFieldSet final : public HExpression<2> {
   void ClearValueCanBeNull() { SetPackedFlag<kFlagValueCanBeNull>(false); }
   bool GetIsPredicatedSet() const { return GetPackedFlag<kFlagIsPredicatedSet>(); }
   void SetIsPredicatedSet(bool value = true) { SetPackedFlag<kFlagIsPredicatedSet>(value); }
+  WriteBarrierKind GetWriteBarrierKind() const { return GetPackedField<WriteBarrierKindField>(); }
+  void SetWriteBarrierKind(WriteBarrierKind kind) {
+    DCHECK(kind != WriteBarrierKind::kEmitWithNullCheck)
+        << "We shouldn't go back to the original value.";
+    SetPackedField<WriteBarrierKindField>(kind);
+  }
 
   DECLARE_INSTRUCTION(InstanceFieldSet);
 
@@ -6352,9 +6381,15 @@ class HInstanceFieldSet final : public HExpression<2> {
  private:
   static constexpr size_t kFlagValueCanBeNull = kNumberOfGenericPackedBits;
   static constexpr size_t kFlagIsPredicatedSet = kFlagValueCanBeNull + 1;
-  static constexpr size_t kNumberOfInstanceFieldSetPackedBits = kFlagIsPredicatedSet + 1;
+  static constexpr size_t kWriteBarrierKind = kFlagIsPredicatedSet + 1;
+  static constexpr size_t kWriteBarrierKindSize =
+      MinimumBitsToStore(static_cast<size_t>(WriteBarrierKind::kLast));
+  static constexpr size_t kNumberOfInstanceFieldSetPackedBits =
+      kWriteBarrierKind + kWriteBarrierKindSize;
   static_assert(kNumberOfInstanceFieldSetPackedBits <= kMaxNumberOfPackedBits,
                 "Too many packed fields.");
+  using WriteBarrierKindField =
+      BitField<WriteBarrierKind, kWriteBarrierKind, kWriteBarrierKindSize>;
 
   const FieldInfo field_info_;
 };
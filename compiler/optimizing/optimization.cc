@@ -55,6 +55,7 @@
 #include "select_generator.h"
 #include "sharpening.h"
 #include "side_effects_analysis.h"
+#include "write_barrier_elimination.h"
 
 // Decide between default or alternative pass name.
 
@@ -95,6 +96,8 @@ const char* OptimizationPassName(OptimizationPass pass) {
       return ConstructorFenceRedundancyElimination::kCFREPassName;
     case OptimizationPass::kScheduling:
       return HInstructionScheduling::kInstructionSchedulingPassName;
+    case OptimizationPass::kWriteBarrierElimination:
+      return WriteBarrierElimination::kWBEPassName;
 #ifdef ART_ENABLE_CODEGEN_arm
     case OptimizationPass::kInstructionSimplifierArm:
       return arm::InstructionSimplifierArm::kInstructionSimplifierArmPassName;
@@ -144,6 +147,7 @@ OptimizationPass OptimizationPassByName(const std::string& pass_name) {
   X(OptimizationPass::kScheduling);
   X(OptimizationPass::kSelectGenerator);
   X(OptimizationPass::kSideEffectsAnalysis);
+  X(OptimizationPass::kWriteBarrierElimination);
 #ifdef ART_ENABLE_CODEGEN_arm
   X(OptimizationPass::kInstructionSimplifierArm);
   X(OptimizationPass::kCriticalNativeAbiFixupArm);
@@ -214,8 +218,21 @@ ArenaVector<HOptimization*> ConstructOptimizations(
         break;
       case OptimizationPass::kBoundsCheckElimination:
         CHECK(most_recent_side_effects != nullptr && most_recent_induction != nullptr);
+        // With loop versioning, AOT code leaves loop-based dynamic elimination to the loop
+        // optimization, since failing a deoptimization test is costly for precompiled code.
+        // This requires the loop optimization to run next with the same induction analysis.
         opt = new (allocator) BoundsCheckElimination(
-            graph, *most_recent_side_effects, most_recent_induction, pass_name);
+            graph,
+            *most_recent_side_effects,
+            most_recent_induction,
+            pass_name,
+            /* prefer_loop_versioning= */ codegen->GetCompilerOptions().IsAotCompiler() &&
+                i + 1 < length &&
+                definitions[i + 1].pass == OptimizationPass::kLoopOptimization &&
+                HLoopOptimization::IsLoopVersioningEnabled(
+                    codegen->GetCompilerOptions(),
+                    graph,
+                    ArchNoOptsLoopHelper::IsLoopPeelingEnabledFor(*codegen)));
         break;
       //
       // Regular passes.
@@ -264,6 +281,9 @@ ArenaVector<HOptimization*> ConstructOptimizations(
       case OptimizationPass::kConstructorFenceRedundancyElimination:
         opt = new (allocator) ConstructorFenceRedundancyElimination(graph, stats, pass_name);
         break;
+      case OptimizationPass::kWriteBarrierElimination:
+        opt = new (allocator) WriteBarrierElimination(graph, stats, pass_name);
+        break;
       case OptimizationPass::kLoadStoreElimination:
         opt = new (allocator) LoadStoreElimination(graph, stats, pass_name);
         break;
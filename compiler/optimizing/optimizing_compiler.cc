@@ -52,6 +52,7 @@
 #include "linker/linker_patch.h"
 #include "nodes.h"
 #include "oat_quick_method_header.h"
+#include "pass_profiler.h"
 #include "prepare_for_register_allocation.h"
 #include "reference_type_propagation.h"
 #include "register_allocator_linear_scan.h"
@@ -66,8 +67,17 @@ namespace art {
 
 static constexpr size_t kArenaAllocatorMemoryReportThreshold = 8 * MB;
 
+// Graphs with more instructions than this only run a reduced set of optimizations,
+// as most passes are not linear in the size of the graph.
+static constexpr size_t kMaximumNumberOfInstructionsForFullOptimization = 16384;
+
 static constexpr const char* kPassNameSeparator = "$";
 
+static bool IsHugeGraph(const HGraph* graph) {
+  return static_cast<size_t>(graph->GetCurrentInstructionId()) >
+      kMaximumNumberOfInstructionsForFullOptimization;
+}
+
 /**
  * Used by the code generator, to allocate the code in a vector.
  */
@@ -103,6 +113,7 @@ class PassObserver : public ValueObject {
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
+               PassProfiler* pass_profiler,
                const CompilerOptions& compiler_options,
                Mutex& dump_mutex)
       : graph_(graph),
@@ -110,6 +121,9 @@ class PassObserver : public ValueObject {
         cached_method_name_(),
         timing_logger_enabled_(compiler_options.GetDumpPassTimings()),
         timing_logger_(timing_logger_enabled_ ? GetMethodName() : "", true, true),
+        pass_profiler_(pass_profiler),
+        pass_start_time_ns_(0u),
+        pass_start_arena_bytes_(0u),
         disasm_info_(graph->GetAllocator()),
         visualizer_oss_(),
         visualizer_output_(visualizer_output),
@@ -166,6 +180,14 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (pass_profiler_ != nullptr) {
+      pass_start_arena_bytes_ = GetArenaBytesUsed();
+      pass_start_time_ns_ = NanoTime();
+    }
+  }
+
+  size_t GetArenaBytesUsed() const {
+    return graph_->GetAllocator()->BytesUsed() + graph_->GetArenaStack()->ApproximatePeakBytes();
   }
 
   void FlushVisualizer() REQUIRES(!visualizer_dump_mutex_) {
@@ -181,6 +203,15 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
+    if (pass_profiler_ != nullptr) {
+      uint64_t time_ns = NanoTime() - pass_start_time_ns_;
+      size_t arena_bytes = GetArenaBytesUsed();
+      pass_profiler_->AddPassRun(
+          pass_name,
+          GetMethodName(),
+          time_ns,
+          arena_bytes > pass_start_arena_bytes_ ? arena_bytes - pass_start_arena_bytes_ : 0u);
+    }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass= */ true, graph_in_bad_state_);
     }
@@ -224,6 +255,11 @@ class PassObserver : public ValueObject {
   bool timing_logger_enabled_;
   TimingLogger timing_logger_;
 
+  // Aggregates pass costs over all compiled methods, if `--dump-pass-profile` is set.
+  PassProfiler* const pass_profiler_;
+  uint64_t pass_start_time_ns_;
+  size_t pass_start_arena_bytes_;
+
   DisassemblyInformation disasm_info_;
 
   std::ostringstream visualizer_oss_;
@@ -406,6 +442,8 @@ class OptimizingCompiler final : public Compiler {
 
   std::unique_ptr<std::ostream> visualizer_output_;
 
+  std::unique_ptr<PassProfiler> pass_profiler_;
+
   mutable Mutex dump_mutex_;  // To synchronize visualizer writing.
 
   DISALLOW_COPY_AND_ASSIGN(OptimizingCompiler);
@@ -428,12 +466,24 @@ OptimizingCompiler::OptimizingCompiler(const CompilerOptions& compiler_options,
   if (compiler_options.GetDumpStats()) {
     compilation_stats_.reset(new OptimizingCompilerStats());
   }
+  if (!compiler_options.GetDumpPassProfileFileName().empty()) {
+    pass_profiler_.reset(new PassProfiler());
+  }
 }
 
 OptimizingCompiler::~OptimizingCompiler() {
   if (compilation_stats_.get() != nullptr) {
     compilation_stats_->Log();
   }
+  if (pass_profiler_ != nullptr) {
+    const std::string& file_name = GetCompilerOptions().GetDumpPassProfileFileName();
+    std::ofstream profile_output(file_name);
+    if (profile_output.good()) {
+      pass_profiler_->DumpJson(profile_output);
+    } else {
+      LOG(WARNING) << "Could not open " << file_name << " to write the pass profile";
+    }
+  }
 }
 
 void OptimizingCompiler::DumpInstructionSetFeaturesToCfg() const {
@@ -544,6 +594,7 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
         OptDef(OptimizationPass::kInstructionSimplifierX86),
         OptDef(OptimizationPass::kSideEffectsAnalysis),
         OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
+        OptDef(OptimizationPass::kScheduling),
         OptDef(OptimizationPass::kPcRelativeFixupsX86),
         OptDef(OptimizationPass::kX86MemoryOperandGeneration)
       };
@@ -560,6 +611,7 @@ bool OptimizingCompiler::RunArchOptimizations(HGraph* graph,
         OptDef(OptimizationPass::kInstructionSimplifierX86_64),
         OptDef(OptimizationPass::kSideEffectsAnalysis),
         OptDef(OptimizationPass::kGlobalValueNumbering, "GVN$after_arch"),
+        OptDef(OptimizationPass::kScheduling),
         OptDef(OptimizationPass::kX86MemoryOperandGeneration)
       };
       return RunOptimizations(graph,
@@ -631,6 +683,26 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
     return;
   }
 
+  if (IsHugeGraph(graph)) {
+    // Only run the cheap simplifications, and the passes required by the code generator.
+    VLOG(compiler) << "Reducing optimizations for huge graph of "
+                   << graph->GetCurrentInstructionId() << " instructions";
+    MaybeRecordStat(compilation_stats_.get(),
+                    MethodCompilationStat::kReducedOptimizationsHugeGraph);
+    OptimizationDef reduced_optimizations[] = {
+      OptDef(OptimizationPass::kConstantFolding),
+      OptDef(OptimizationPass::kInstructionSimplifier),
+      OptDef(OptimizationPass::kDeadCodeElimination),
+    };
+    RunOptimizations(graph,
+                     codegen,
+                     dex_compilation_unit,
+                     pass_observer,
+                     reduced_optimizations);
+    RunBaselineOptimizations(graph, codegen, dex_compilation_unit, pass_observer);
+    return;
+  }
+
   OptimizationDef optimizations[] = {
     // Initial optimizations.
     OptDef(OptimizationPass::kConstantFolding),
@@ -695,6 +767,29 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
                    optimizations);
 
   RunArchOptimizations(graph, codegen, dex_compilation_unit, pass_observer);
+
+  // Eliminate write barriers after all other passes, including the instruction scheduler, so
+  // that no GC point is moved between stores relying on the same card mark.
+  OptimizationDef final_optimizations[] = {
+    OptDef(OptimizationPass::kWriteBarrierElimination)
+  };
+  RunOptimizations(graph,
+                   codegen,
+                   dex_compilation_unit,
+                   pass_observer,
+                   final_optimizations);
+}
+
+// Record the arena memory used to compile a method, in KiB, for `--dump-stats`.
+static void RecordArenaUsage(OptimizingCompilerStats* compilation_stats,
+                             ArenaAllocator* allocator,
+                             ArenaStack* arena_stack) {
+  if (compilation_stats == nullptr) {
+    return;
+  }
+  size_t bytes = allocator->BytesUsed() + arena_stack->ApproximatePeakBytes();
+  compilation_stats->RecordStat(MethodCompilationStat::kArenaKiBUsed,
+                                static_cast<uint32_t>(bytes / KB));
 }
 
 static ArenaVector<linker::LinkerPatch> EmitAndSortLinkerPatches(CodeGenerator* codegen) {
@@ -829,6 +924,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             pass_profiler_.get(),
                              compiler_options,
                              dump_mutex_);
 
@@ -890,6 +986,15 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
 
   RegisterAllocator::Strategy regalloc_strategy =
     compiler_options.GetRegisterAllocationStrategy();
+  if (regalloc_strategy != RegisterAllocator::kRegisterAllocatorLinearScan && IsHugeGraph(graph)) {
+    // The graph coloring allocator builds an interference graph that is quadratic
+    // in the number of live intervals; fall back to linear scan for huge graphs.
+    VLOG(compiler) << "Using linear scan register allocation for huge graph of "
+                   << graph->GetCurrentInstructionId() << " instructions";
+    MaybeRecordStat(compilation_stats_.get(),
+                    MethodCompilationStat::kLinearScanRegisterAllocationHugeGraph);
+    regalloc_strategy = RegisterAllocator::kRegisterAllocatorLinearScan;
+  }
   AllocateRegisters(graph,
                     codegen.get(),
                     &pass_observer,
@@ -953,6 +1058,7 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
+                             pass_profiler_.get(),
                              compiler_options,
                              dump_mutex_);
 
@@ -1093,6 +1199,8 @@ CompiledMethod* OptimizingCompiler::Compile(const dex::CodeItem* code_item,
       }
     }
   }
+  // Record after `Emit()` so that the peak includes code generation and stack maps.
+  RecordArenaUsage(compilation_stats_.get(), &allocator, &arena_stack);
 
   if (kIsDebugBuild &&
       compiler_options.CompileArtTest() &&
@@ -1410,6 +1518,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
   }
 
   Runtime::Current()->GetJit()->AddMemoryUsage(method, allocator.BytesUsed());
+  RecordArenaUsage(compilation_stats_.get(), &allocator, &arena_stack);
   if (jit_logger != nullptr) {
     jit_logger->WriteLog(code, code_allocator.GetMemory().size(), method);
   }
@@ -60,8 +60,11 @@ enum class MethodCompilationStat {
   kNotCompiledUnsupportedIsa,
   kNotCompiledIrreducibleLoopAndStringInit,
   kNotCompiledPhiEquivalentInOsr,
+  kReducedOptimizationsHugeGraph,
+  kLinearScanRegisterAllocationHugeGraph,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
+  kInlinedHotCallSite,
   kMonomorphicCall,
   kPolymorphicCall,
   kMegamorphicCall,
@@ -70,6 +73,8 @@ enum class MethodCompilationStat {
   kLoopInvariantMoved,
   kLoopVectorized,
   kLoopVectorizedIdiom,
+  kLoopUnswitched,
+  kLoopVersionedForBoundsChecks,
   kSelectGenerated,
   kRemovedInstanceOf,
   kInlinedInvokeVirtualOrInterface,
@@ -92,6 +97,7 @@ enum class MethodCompilationStat {
   kNotInlinedCannotBuild,
   kNotInlinedNotVerified,
   kNotInlinedCodeItem,
+  kNotInlinedColdCallSite,
   kNotInlinedWont,
   kNotInlinedRecursiveBudget,
   kNotInlinedProxy,
@@ -115,6 +121,13 @@ enum class MethodCompilationStat {
   kPredicatedLoadAdded,
   kPredicatedStoreAdded,
   kDevirtualized,
+  kDevirtualizedMethodHandleInvokeExact,
+  kColdBlocksMoved,
+  kHotCodeBytes,
+  kColdCodeBytes,
+  kRemovedWriteBarrier,
+  kCoalescedWriteBarrier,
+  kArenaKiBUsed,
   kLastStat
 };
 std::ostream& operator<<(std::ostream& os, MethodCompilationStat rhs);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pass_profiler.h"
+
+#include <algorithm>
+
+#include "thread-current-inl.h"
+
+namespace art {
+
+void PassProfiler::AddPassRun(const char* pass_name,
+                              const char* method_name,
+                              uint64_t time_ns,
+                              size_t arena_bytes) {
+  MutexLock mu(Thread::Current(), lock_);
+  PassProfile& profile = passes_[pass_name];
+  ++profile.runs;
+  profile.total_time_ns += time_ns;
+  profile.total_arena_bytes += arena_bytes;
+  profile.peak_arena_bytes = std::max(profile.peak_arena_bytes, arena_bytes);
+
+  std::vector<MethodCost>& top_methods = profile.top_methods;
+  if (top_methods.size() == kNumberOfTopMethods && top_methods.back().time_ns >= time_ns) {
+    return;
+  }
+  auto it = std::upper_bound(top_methods.begin(),
+                             top_methods.end(),
+                             time_ns,
+                             [](uint64_t time, const MethodCost& cost) {
+                               return time > cost.time_ns;
+                             });
+  top_methods.insert(it, MethodCost{method_name, time_ns});
+  if (top_methods.size() > kNumberOfTopMethods) {
+    top_methods.pop_back();
+  }
+}
+
+static void DumpJsonString(std::ostream& os, const std::string& str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+void PassProfiler::DumpJson(std::ostream& os) const {
+  MutexLock mu(Thread::Current(), lock_);
+  std::vector<const std::pair<const std::string, PassProfile>*> sorted_passes;
+  sorted_passes.reserve(passes_.size());
+  for (const auto& entry : passes_) {
+    sorted_passes.push_back(&entry);
+  }
+  std::stable_sort(sorted_passes.begin(),
+                   sorted_passes.end(),
+                   [](const auto* lhs, const auto* rhs) {
+                     return lhs->second.total_time_ns > rhs->second.total_time_ns;
+                   });
+
+  os << "{\n  \"passes\": [";
+  const char* pass_separator = "\n";
+  for (const auto* entry : sorted_passes) {
+    const PassProfile& profile = entry->second;
+    os << pass_separator << "    {\n      \"name\": ";
+    DumpJsonString(os, entry->first);
+    os << ",\n      \"runs\": " << profile.runs
+       << ",\n      \"total_time_ns\": " << profile.total_time_ns
+       << ",\n      \"total_arena_bytes\": " << profile.total_arena_bytes
+       << ",\n      \"peak_arena_bytes\": " << profile.peak_arena_bytes
+       << ",\n      \"top_methods\": [";
+    const char* method_separator = "\n";
+    for (const MethodCost& cost : profile.top_methods) {
+      os << method_separator << "        {\"method\": ";
+      DumpJsonString(os, cost.method_name);
+      os << ", \"time_ns\": " << cost.time_ns << "}";
+      method_separator = ",\n";
+    }
+    os << "\n      ]\n    }";
+    pass_separator = ",\n";
+  }
+  os << "\n  ]\n}\n";
+}
+
+}  // namespace art
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_PASS_PROFILER_H_
+#define ART_COMPILER_OPTIMIZING_PASS_PROFILER_H_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+
+namespace art {
+
+/**
+ * Aggregates the wall time and arena memory spent in each pass of the optimizing
+ * compiler over all compiled methods, and keeps the most expensive methods of each
+ * pass. Used by `--dump-pass-profile` to write a JSON profile of a whole compilation.
+ */
+class PassProfiler {
+ public:
+  // Number of most expensive methods reported for each pass.
+  static constexpr size_t kNumberOfTopMethods = 10;
+
+  PassProfiler() : lock_("Pass profiler lock") {}
+
+  // Record a run of the pass `pass_name` on `method_name` that took `time_ns`
+  // nanoseconds and grew the arena memory used for the method by `arena_bytes`.
+  void AddPassRun(const char* pass_name,
+                  const char* method_name,
+                  uint64_t time_ns,
+                  size_t arena_bytes) REQUIRES(!lock_);
+
+  // Write the profile as JSON, with passes sorted by decreasing total time.
+  void DumpJson(std::ostream& os) const REQUIRES(!lock_);
+
+ private:
+  struct MethodCost {
+    std::string method_name;
+    uint64_t time_ns;
+  };
+
+  struct PassProfile {
+    size_t runs = 0u;
+    uint64_t total_time_ns = 0u;
+    uint64_t total_arena_bytes = 0u;
+    size_t peak_arena_bytes = 0u;
+    // Sorted by decreasing time.
+    std::vector<MethodCost> top_methods;
+  };
+
+  mutable Mutex lock_;
+  std::map<std::string, PassProfile> passes_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(PassProfiler);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_PASS_PROFILER_H_
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pass_profiler.h"
+
+#include <sstream>
+#include <string>
+
+#include "base/common_art_test.h"
+
+namespace art {
+
+class PassProfilerTest : public CommonArtTest {};
+
+TEST_F(PassProfilerTest, Empty) {
+  PassProfiler profiler;
+  std::ostringstream oss;
+  profiler.DumpJson(oss);
+  EXPECT_EQ("{\n  \"passes\": [\n  ]\n}\n", oss.str());
+}
+
+TEST_F(PassProfilerTest, AggregatesAndSortsPasses) {
+  PassProfiler profiler;
+  profiler.AddPassRun("gvn", "void A.foo()", 10u, 100u);
+  profiler.AddPassRun("licm", "void A.foo()", 50u, 0u);
+  profiler.AddPassRun("gvn", "void A.bar()", 30u, 300u);
+
+  std::ostringstream oss;
+  profiler.DumpJson(oss);
+  std::string expected =
+      "{\n"
+      "  \"passes\": [\n"
+      "    {\n"
+      "      \"name\": \"licm\",\n"
+      "      \"runs\": 1,\n"
+      "      \"total_time_ns\": 50,\n"
+      "      \"total_arena_bytes\": 0,\n"
+      "      \"peak_arena_bytes\": 0,\n"
+      "      \"top_methods\": [\n"
+      "        {\"method\": \"void A.foo()\", \"time_ns\": 50}\n"
+      "      ]\n"
+      "    },\n"
+      "    {\n"
+      "      \"name\": \"gvn\",\n"
+      "      \"runs\": 2,\n"
+      "      \"total_time_ns\": 40,\n"
+      "      \"total_arena_bytes\": 400,\n"
+      "      \"peak_arena_bytes\": 300,\n"
+      "      \"top_methods\": [\n"
+      "        {\"method\": \"void A.bar()\", \"time_ns\": 30},\n"
+      "        {\"method\": \"void A.foo()\", \"time_ns\": 10}\n"
+      "      ]\n"
+      "    }\n"
+      "  ]\n"
+      "}\n";
+  EXPECT_EQ(expected, oss.str());
+}
+
+TEST_F(PassProfilerTest, KeepsTopMethods) {
+  constexpr size_t kTop = PassProfiler::kNumberOfTopMethods;
+  PassProfiler profiler;
+  for (size_t i = 0; i != 2 * kTop; ++i) {
+    profiler.AddPassRun("inliner", ("m" + std::to_string(i)).c_str(), i, 0u);
+  }
+  std::ostringstream oss;
+  profiler.DumpJson(oss);
+  std::string json = oss.str();
+  auto position_of = [&](size_t i) { return json.find("\"m" + std::to_string(i) + "\""); };
+  // Only the slowest methods are kept, slowest first.
+  for (size_t i = 0; i != kTop; ++i) {
+    EXPECT_EQ(std::string::npos, position_of(i));
+  }
+  for (size_t i = kTop; i + 1 != 2 * kTop; ++i) {
+    EXPECT_NE(std::string::npos, position_of(i));
+    EXPECT_GT(position_of(i), position_of(i + 1));
+  }
+}
+
+}  // namespace art
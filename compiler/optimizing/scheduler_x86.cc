@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scheduler_x86.h"
+
+#include "code_generator_utils.h"
+#include "mirror/string.h"
+
+namespace art {
+namespace x86 {
+
+void SchedulingLatencyVisitorX86::VisitBinaryOperation(HBinaryOperation* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? kX86FloatingPointOpLatency
+      : kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitX86AndNot(HX86AndNot* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitX86MaskOrResetLeastSetBit(
+    HX86MaskOrResetLeastSetBit* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitArrayGet(HArrayGet* instruction) {
+  if (instruction->IsStringCharAt() && mirror::kUseStringCompression) {
+    // Take the compression flag test and branch into account.
+    last_visited_internal_latency_ = kX86MemoryLoadLatency + kX86IntegerOpLatency;
+  }
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitArrayLength(HArrayLength* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitArraySet(HArraySet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86MemoryStoreLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitBoundsCheck(HBoundsCheck* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86IntegerOpLatency;
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86::VisitDiv(HDiv* instr) {
+  DataType::Type type = instr->GetResultType();
+  switch (type) {
+    case DataType::Type::kFloat32:
+      last_visited_latency_ = kX86DivFloatLatency;
+      break;
+    case DataType::Type::kFloat64:
+      last_visited_latency_ = kX86DivDoubleLatency;
+      break;
+    default:
+      // Follow the code path used by code generation.
+      if (instr->GetRight()->IsConstant()) {
+        int64_t imm = Int64FromConstant(instr->GetRight()->AsConstant());
+        if (imm == 0) {
+          last_visited_internal_latency_ = 0;
+          last_visited_latency_ = 0;
+        } else if (imm == 1 || imm == -1) {
+          last_visited_internal_latency_ = 0;
+          last_visited_latency_ = kX86IntegerOpLatency;
+        } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+          last_visited_internal_latency_ = 3 * kX86IntegerOpLatency;
+          last_visited_latency_ = kX86IntegerOpLatency;
+        } else {
+          DCHECK(imm <= -2 || imm >= 2);
+          last_visited_internal_latency_ = kX86MulIntegerLatency + 2 * kX86IntegerOpLatency;
+          last_visited_latency_ = kX86IntegerOpLatency;
+        }
+      } else {
+        last_visited_latency_ = (type == DataType::Type::kInt64)
+            ? kX86DivLongLatency
+            : kX86DivIntegerLatency;
+      }
+      break;
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitInstanceFieldGet(HInstanceFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitInstanceOf(HInstanceOf* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86CallInternalLatency;
+  last_visited_latency_ = kX86IntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitInvoke(HInvoke* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86CallInternalLatency;
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitLoadString(HLoadString* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86LoadStringInternalLatency;
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitMul(HMul* instr) {
+  last_visited_latency_ = DataType::IsFloatingPointType(instr->GetResultType())
+      ? kX86MulFloatingPointLatency
+      : kX86MulIntegerLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitNewArray(HNewArray* ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86IntegerOpLatency + kX86CallInternalLatency;
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitNewInstance(HNewInstance* instruction) {
+  if (instruction->IsStringAlloc()) {
+    last_visited_internal_latency_ = 2 + kX86MemoryLoadLatency + kX86CallInternalLatency;
+  } else {
+    last_visited_internal_latency_ = kX86CallInternalLatency;
+  }
+  last_visited_latency_ = kX86CallLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitRem(HRem* instruction) {
+  DataType::Type type = instruction->GetResultType();
+  if (DataType::IsFloatingPointType(type)) {
+    // Generated as an x87 `fprem` loop.
+    last_visited_internal_latency_ = kX86CallInternalLatency;
+    last_visited_latency_ = kX86CallLatency;
+  } else if (instruction->GetRight()->IsConstant()) {
+    // Follow the code path used by code generation.
+    int64_t imm = Int64FromConstant(instruction->GetRight()->AsConstant());
+    if (imm == 0) {
+      last_visited_internal_latency_ = 0;
+      last_visited_latency_ = 0;
+    } else if (imm == 1 || imm == -1) {
+      last_visited_internal_latency_ = 0;
+      last_visited_latency_ = kX86IntegerOpLatency;
+    } else if (IsPowerOfTwo(AbsOrMin(imm))) {
+      last_visited_internal_latency_ = 3 * kX86IntegerOpLatency;
+      last_visited_latency_ = kX86IntegerOpLatency;
+    } else {
+      DCHECK(imm <= -2 || imm >= 2);
+      last_visited_internal_latency_ = 2 * kX86MulIntegerLatency + 2 * kX86IntegerOpLatency;
+      last_visited_latency_ = kX86IntegerOpLatency;
+    }
+  } else {
+    last_visited_latency_ = (type == DataType::Type::kInt64)
+        ? kX86DivLongLatency
+        : kX86DivIntegerLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitStaticFieldGet(HStaticFieldGet* ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86MemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitSuspendCheck(HSuspendCheck* instruction) {
+  HBasicBlock* block = instruction->GetBlock();
+  DCHECK((block->GetLoopInformation() != nullptr) ||
+         (block->IsEntryBlock() && instruction->GetNext()->IsGoto()));
+  // Users do not use any data results.
+  last_visited_latency_ = 0;
+}
+
+void SchedulingLatencyVisitorX86::VisitTypeConversion(HTypeConversion* instr) {
+  if (DataType::IsFloatingPointType(instr->GetResultType()) ||
+      DataType::IsFloatingPointType(instr->GetInputType())) {
+    last_visited_latency_ = kX86TypeConversionFloatingPointIntegerLatency;
+  } else {
+    last_visited_latency_ = kX86IntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86::HandleSimpleArithmeticSIMD(HVecOperation* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = kX86SIMDFloatingPointOpLatency;
+  } else {
+    last_visited_latency_ = kX86SIMDIntegerOpLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitVecReplicateScalar(
+    HVecReplicateScalar* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDReplicateOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecExtractScalar(HVecExtractScalar* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecReduce(HVecReduce* instr) {
+  // Reductions are a sequence of horizontal operations.
+  last_visited_internal_latency_ = 2 * kX86SIMDFloatingPointOpLatency;
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecCnv(HVecCnv* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDTypeConversionInt2FPLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecNeg(HVecNeg* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecAbs(HVecAbs* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecNot(HVecNot* instr ATTRIBUTE_UNUSED) {
+  last_visited_internal_latency_ = kX86SIMDIntegerOpLatency;
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecAdd(HVecAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecHalvingAdd(HVecHalvingAdd* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecSub(HVecSub* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecMul(HVecMul* instr) {
+  if (DataType::IsFloatingPointType(instr->GetPackedType())) {
+    last_visited_latency_ = kX86SIMDMulFloatingPointLatency;
+  } else {
+    last_visited_latency_ = kX86SIMDMulIntegerLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitVecDiv(HVecDiv* instr) {
+  if (instr->GetPackedType() == DataType::Type::kFloat32) {
+    last_visited_latency_ = kX86SIMDDivFloatLatency;
+  } else {
+    DCHECK(instr->GetPackedType() == DataType::Type::kFloat64);
+    last_visited_latency_ = kX86SIMDDivDoubleLatency;
+  }
+}
+
+void SchedulingLatencyVisitorX86::VisitVecMin(HVecMin* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecMax(HVecMax* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecAnd(HVecAnd* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecAndNot(HVecAndNot* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecOr(HVecOr* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecXor(HVecXor* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecShl(HVecShl* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecShr(HVecShr* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecUShr(HVecUShr* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecSetScalars(HVecSetScalars* instr) {
+  HandleSimpleArithmeticSIMD(instr);
+}
+
+void SchedulingLatencyVisitorX86::VisitVecMultiplyAccumulate(
+    HVecMultiplyAccumulate* instr ATTRIBUTE_UNUSED) {
+  // There is no integer multiply-accumulate; it is emitted as a multiplication and an addition.
+  last_visited_internal_latency_ = kX86SIMDMulIntegerLatency;
+  last_visited_latency_ = kX86SIMDIntegerOpLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecLoad(HVecLoad* instr) {
+  if (instr->IsStringCharAt() && mirror::kUseStringCompression) {
+    // Set latencies for the uncompressed case.
+    last_visited_internal_latency_ = kX86MemoryLoadLatency + kX86IntegerOpLatency;
+  }
+  last_visited_latency_ = kX86SIMDMemoryLoadLatency;
+}
+
+void SchedulingLatencyVisitorX86::VisitVecStore(HVecStore* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kX86SIMDMemoryStoreLatency;
+}
+
+}  // namespace x86
+}  // namespace art
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_SCHEDULER_X86_H_
+#define ART_COMPILER_OPTIMIZING_SCHEDULER_X86_H_
+
+#include "scheduler.h"
+
+namespace art {
+namespace x86 {
+
+// Latencies shared by x86 and x86-64, modeled after recent out-of-order cores. These cores hide
+// most of the latency of simple instructions, so the model mostly tries to separate long latency
+// operations (loads, multiplications, divisions) from their uses.
+static constexpr uint32_t kX86MemoryLoadLatency = 5;
+static constexpr uint32_t kX86MemoryStoreLatency = 1;
+
+static constexpr uint32_t kX86CallInternalLatency = 10;
+static constexpr uint32_t kX86CallLatency = 5;
+
+static constexpr uint32_t kX86IntegerOpLatency = 1;
+static constexpr uint32_t kX86FloatingPointOpLatency = 4;
+
+static constexpr uint32_t kX86DivDoubleLatency = 14;
+static constexpr uint32_t kX86DivFloatLatency = 11;
+static constexpr uint32_t kX86DivIntegerLatency = 26;
+static constexpr uint32_t kX86DivLongLatency = 40;
+static constexpr uint32_t kX86LoadStringInternalLatency = 6;
+static constexpr uint32_t kX86MulFloatingPointLatency = 4;
+static constexpr uint32_t kX86MulIntegerLatency = 3;
+static constexpr uint32_t kX86TypeConversionFloatingPointIntegerLatency = 6;
+
+static constexpr uint32_t kX86SIMDFloatingPointOpLatency = 4;
+static constexpr uint32_t kX86SIMDIntegerOpLatency = 1;
+static constexpr uint32_t kX86SIMDMemoryLoadLatency = 6;
+static constexpr uint32_t kX86SIMDMemoryStoreLatency = 1;
+static constexpr uint32_t kX86SIMDMulFloatingPointLatency = 4;
+static constexpr uint32_t kX86SIMDMulIntegerLatency = 10;
+static constexpr uint32_t kX86SIMDReplicateOpLatency = 3;
+static constexpr uint32_t kX86SIMDDivDoubleLatency = 14;
+static constexpr uint32_t kX86SIMDDivFloatLatency = 11;
+static constexpr uint32_t kX86SIMDTypeConversionInt2FPLatency = 4;
+
+class SchedulingLatencyVisitorX86 : public SchedulingLatencyVisitor {
+ public:
+  // Default visitor for instructions not handled specifically below.
+  void VisitInstruction(HInstruction* ATTRIBUTE_UNUSED) override {
+    last_visited_latency_ = kX86IntegerOpLatency;
+  }
+
+// We add a second unused parameter to be able to use this macro like the others
+// defined in `nodes.h`.
+#define FOR_EACH_SCHEDULED_X86_COMMON_INSTRUCTION(M) \
+  M(ArrayGet             , unused)                   \
+  M(ArrayLength          , unused)                   \
+  M(ArraySet             , unused)                   \
+  M(BoundsCheck          , unused)                   \
+  M(Div                  , unused)                   \
+  M(InstanceFieldGet     , unused)                   \
+  M(InstanceOf           , unused)                   \
+  M(LoadString           , unused)                   \
+  M(Mul                  , unused)                   \
+  M(NewArray             , unused)                   \
+  M(NewInstance          , unused)                   \
+  M(Rem                  , unused)                   \
+  M(StaticFieldGet       , unused)                   \
+  M(SuspendCheck         , unused)                   \
+  M(TypeConversion       , unused)                   \
+  M(VecReplicateScalar   , unused)                   \
+  M(VecExtractScalar     , unused)                   \
+  M(VecReduce            , unused)                   \
+  M(VecCnv               , unused)                   \
+  M(VecNeg               , unused)                   \
+  M(VecAbs               , unused)                   \
+  M(VecNot               , unused)                   \
+  M(VecAdd               , unused)                   \
+  M(VecHalvingAdd        , unused)                   \
+  M(VecSub               , unused)                   \
+  M(VecMul               , unused)                   \
+  M(VecDiv               , unused)                   \
+  M(VecMin               , unused)                   \
+  M(VecMax               , unused)                   \
+  M(VecAnd               , unused)                   \
+  M(VecAndNot            , unused)                   \
+  M(VecOr                , unused)                   \
+  M(VecXor               , unused)                   \
+  M(VecShl               , unused)                   \
+  M(VecShr               , unused)                   \
+  M(VecUShr              , unused)                   \
+  M(VecSetScalars        , unused)                   \
+  M(VecMultiplyAccumulate, unused)                   \
+  M(VecLoad              , unused)                   \
+  M(VecStore             , unused)
+
+#define FOR_EACH_SCHEDULED_X86_ABSTRACT_INSTRUCTION(M) \
+  M(BinaryOperation      , unused)                     \
+  M(Invoke               , unused)
+
+#define DECLARE_VISIT_INSTRUCTION(type, unused)  \
+  void Visit##type(H##type* instruction) override;
+
+  FOR_EACH_SCHEDULED_X86_COMMON_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_SCHEDULED_X86_ABSTRACT_INSTRUCTION(DECLARE_VISIT_INSTRUCTION)
+  FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(DECLARE_VISIT_INSTRUCTION)
+
+#undef DECLARE_VISIT_INSTRUCTION
+
+ private:
+  void HandleSimpleArithmeticSIMD(HVecOperation* instr);
+};
+
+class HSchedulerX86 : public HScheduler {
+ public:
+  explicit HSchedulerX86(SchedulingNodeSelector* selector)
+      : HScheduler(&x86_latency_visitor_, selector) {}
+  ~HSchedulerX86() override {}
+
+  bool IsSchedulable(const HInstruction* instruction) const override {
+#define CASE_INSTRUCTION_KIND(type, unused) case \
+  HInstruction::InstructionKind::k##type:
+    switch (instruction->GetKind()) {
+      FOR_EACH_CONCRETE_INSTRUCTION_X86_COMMON(CASE_INSTRUCTION_KIND)
+        return true;
+      FOR_EACH_SCHEDULED_X86_COMMON_INSTRUCTION(CASE_INSTRUCTION_KIND)
+        return true;
+      default:
+        return HScheduler::IsSchedulable(instruction);
+    }
+#undef CASE_INSTRUCTION_KIND
+  }
+
+  // No vector register is preserved across calls: 32-bit x86 has no callee-save XMM registers,
+  // and x86-64 only preserves the lower 64 bits of XMM12-XMM15. Do not reorder the vector
+  // instructions which move values in and out of the vectorized loop, so that their live ranges
+  // are not extended, as they would need full-width spills around any call they cross.
+  bool IsSchedulingBarrier(const HInstruction* instr) const override {
+    return HScheduler::IsSchedulingBarrier(instr) ||
+           instr->IsVecReduce() ||
+           instr->IsVecExtractScalar() ||
+           instr->IsVecSetScalars() ||
+           instr->IsVecReplicateScalar();
+  }
+
+ private:
+  SchedulingLatencyVisitorX86 x86_latency_visitor_;
+  DISALLOW_COPY_AND_ASSIGN(HSchedulerX86);
+};
+
+}  // namespace x86
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_SCHEDULER_X86_H_
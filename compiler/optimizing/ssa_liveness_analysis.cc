@@ -82,16 +82,13 @@ void SsaLivenessAnalysis::NumberInstructions() {
     }
 
     block->SetLifetimeEnd(lifetime_position);
+    block_infos_[block->GetBlockId()] =
+        new (allocator_) BlockInfo(allocator_, *block, ssa_index);
   }
   number_of_ssa_values_ = ssa_index;
 }
 
 void SsaLivenessAnalysis::ComputeLiveness() {
-  for (HBasicBlock* block : graph_->GetLinearOrder()) {
-    block_infos_[block->GetBlockId()] =
-        new (allocator_) BlockInfo(allocator_, *block, number_of_ssa_values_);
-  }
-
   // Compute the live ranges, as well as the initial live_in, live_out, and kill sets.
   // This method does not handle backward branches for the sets, therefore live_in
   // and live_out sets are not yet correct.
@@ -32,12 +32,17 @@ class SsaLivenessAnalysis;
 
 static constexpr int kNoRegister = -1;
 
+// Liveness information of a block. SSA values are numbered in linear order, and values live
+// in or out of the block are defined by the block or its dominators, so the sets are sized to
+// `number_of_ssa_values`, the number of values defined up to the end of the block, instead of
+// the total number of SSA values. This roughly halves their memory for large methods. The live
+// sets remain expandable in case that assumption does not hold.
 class BlockInfo : public ArenaObject<kArenaAllocSsaLiveness> {
  public:
   BlockInfo(ScopedArenaAllocator* allocator, const HBasicBlock& block, size_t number_of_ssa_values)
       : block_(block),
-        live_in_(allocator, number_of_ssa_values, false, kArenaAllocSsaLiveness),
-        live_out_(allocator, number_of_ssa_values, false, kArenaAllocSsaLiveness),
+        live_in_(allocator, number_of_ssa_values, /* expandable= */ true, kArenaAllocSsaLiveness),
+        live_out_(allocator, number_of_ssa_values, /* expandable= */ true, kArenaAllocSsaLiveness),
         kill_(allocator, number_of_ssa_values, false, kArenaAllocSsaLiveness) {
     UNUSED(block_);
     live_in_.ClearAllBits();
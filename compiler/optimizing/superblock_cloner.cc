@@ -1139,6 +1139,25 @@ bool LoopClonerHelper::IsLoopClonable(HLoopInformation* loop_info) {
   return helper.IsLoopClonable();
 }
 
+bool LoopClonerHelper::IsLoopVersionable(HLoopInformation* loop_info, bool check_size) {
+  if (loop_info->IsIrreducible()) {
+    return false;
+  }
+  size_t num_instructions = 0;
+  for (HBlocksInLoopIterator it(*loop_info); !it.Done(); it.Advance()) {
+    HBasicBlock* block = it.Current();
+    // Only innermost loops are versioned.
+    if (block->GetLoopInformation() != loop_info) {
+      return false;
+    }
+    num_instructions += block->GetInstructions().CountSize();
+    if (check_size && num_instructions > kMaxVersionedLoopInstructions) {
+      return false;
+    }
+  }
+  return IsLoopClonable(loop_info);
+}
+
 HBasicBlock* LoopClonerHelper::DoLoopTransformationImpl(TransformationKind transformation) {
   // For now do transformations only for natural loops.
   DCHECK(!loop_info_->IsIrreducible());
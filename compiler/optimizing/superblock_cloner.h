@@ -397,6 +397,14 @@ class LoopClonerHelper : public ValueObject {
   // Returns whether the loop can be peeled/unrolled.
   bool IsLoopClonable() const { return cloner_.IsSubgraphClonable(); }
 
+  // Returns whether the loop is a candidate for versioning: an innermost clonable loop which is
+  // small enough for the duplicated code to pay off, unless 'check_size' is false (static
+  // function).
+  static bool IsLoopVersionable(HLoopInformation* loop_info, bool check_size = true);
+
+  // Loops with more instructions than this are not versioned.
+  static constexpr size_t kMaxVersionedLoopInstructions = 64;
+
   // Perform loop peeling.
   //
   // Control flow of an example (ignoring critical edges splitting).
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "write_barrier_elimination.h"
+
+#include "base/arena_allocator.h"
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "code_generator.h"
+#include "read_barrier_config.h"
+
+namespace art {
+
+class WBEVisitor : public HGraphVisitor {
+ public:
+  WBEVisitor(HGraph* graph, OptimizingCompilerStats* stats)
+      : HGraphVisitor(graph),
+        scoped_allocator_(graph->GetArenaStack()),
+        fresh_objects_(scoped_allocator_.Adapter(kArenaAllocWBE)),
+        current_write_barriers_(scoped_allocator_.Adapter(kArenaAllocWBE)),
+        stats_(stats) {}
+
+  void VisitBasicBlock(HBasicBlock* block) override {
+    // The analysis is local to the block: control flow merges are treated as GC points.
+    ClearCurrentValues();
+    HGraphVisitor::VisitBasicBlock(block);
+  }
+
+  void VisitInstanceFieldSet(HInstanceFieldSet* instruction) override {
+    DCHECK(!instruction->GetSideEffects().Includes(SideEffects::CanTriggerGC()));
+    DCHECK(!instruction->CanThrow());
+    if (!CodeGenerator::StoreNeedsWriteBarrier(instruction->GetFieldType(),
+                                               instruction->GetValue())) {
+      return;
+    }
+
+    HInstruction* obj = instruction->InputAt(0);
+    if (fresh_objects_.find(obj) != fresh_objects_.end()) {
+      instruction->SetWriteBarrierKind(WriteBarrierKind::kDontEmit);
+      MaybeRecordStat(stats_, MethodCompilationStat::kRemovedWriteBarrier);
+      return;
+    }
+
+    auto it = current_write_barriers_.find(obj);
+    if (it != current_write_barriers_.end()) {
+      // The card mark of the previous store is moved to this one, which now has to mark the
+      // card unconditionally.
+      DCHECK(it->second->GetWriteBarrierKind() != WriteBarrierKind::kDontEmit);
+      it->second->SetWriteBarrierKind(WriteBarrierKind::kDontEmit);
+      instruction->SetWriteBarrierKind(WriteBarrierKind::kEmitNoNullCheck);
+      it->second = instruction;
+      MaybeRecordStat(stats_, MethodCompilationStat::kCoalescedWriteBarrier);
+    } else {
+      current_write_barriers_.insert({obj, instruction});
+    }
+  }
+
+  void VisitNewInstance(HNewInstance* new_instance) override {
+    ClearCurrentValues();
+    // Stores into objects allocated since the last GC do not need to be recorded in the card
+    // table by the generational concurrent copying collector, as the young collection visits
+    // all of them. Other collectors may rely on the card mark of new objects.
+    if (kEmitCompilerReadBarrier) {
+      fresh_objects_.insert(new_instance);
+    }
+  }
+
+  void VisitInstruction(HInstruction* instruction) override {
+    // An exception thrown between coalesced stores would skip the remaining card mark.
+    if (instruction->GetSideEffects().Includes(SideEffects::CanTriggerGC()) ||
+        instruction->CanThrow()) {
+      ClearCurrentValues();
+    }
+  }
+
+ private:
+  void ClearCurrentValues() {
+    fresh_objects_.clear();
+    current_write_barriers_.clear();
+  }
+
+  // Phase-local heap memory allocator for WBE optimizer.
+  ScopedArenaAllocator scoped_allocator_;
+
+  // Objects allocated in the current block with no GC point since their allocation.
+  ScopedArenaHashSet<HInstruction*> fresh_objects_;
+
+  // The last store with a write barrier for each object since the last GC point.
+  ScopedArenaHashMap<HInstruction*, HInstanceFieldSet*> current_write_barriers_;
+
+  // Used to record stats about the optimization.
+  OptimizingCompilerStats* const stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(WBEVisitor);
+};
+
+bool WriteBarrierElimination::Run() {
+  WBEVisitor wbe_visitor(graph_, stats_);
+  wbe_visitor.VisitReversePostOrder();
+  return true;
+}
+
+}  // namespace art
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_WRITE_BARRIER_ELIMINATION_H_
+#define ART_COMPILER_OPTIMIZING_WRITE_BARRIER_ELIMINATION_H_
+
+#include "base/macros.h"
+#include "optimization.h"
+
+namespace art {
+
+/*
+ * Write Barrier Elimination (WBE).
+ *
+ * A local optimization pass that removes redundant card marks of instance field
+ * stores within the same basic block. A GC point is any instruction that can
+ * trigger GC (including suspend checks) or that can throw.
+ *
+ * - A store into an object allocated by an HNewInstance with no GC point
+ *   between the allocation and the store does not need a card mark: the object
+ *   is still young and will be fully visited by the next GC. This is only done
+ *   for the concurrent copying collector.
+ * - Consecutive stores into the same object with no GC point between them are
+ *   coalesced into a single card mark emitted by the last store. That card mark
+ *   skips the null check of the stored value as it also covers the other stores.
+ *
+ * The pass runs after all other optimizations, so that no pass can move a GC
+ * point between coalesced stores.
+ */
+class WriteBarrierElimination : public HOptimization {
+ public:
+  WriteBarrierElimination(HGraph* graph,
+                          OptimizingCompilerStats* stats,
+                          const char* name = kWBEPassName)
+      : HOptimization(graph, name, stats) {}
+
+  bool Run() override;
+
+  static constexpr const char* kWBEPassName = "write_barrier_elimination";
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(WriteBarrierElimination);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_WRITE_BARRIER_ELIMINATION_H_
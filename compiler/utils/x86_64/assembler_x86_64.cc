@@ -32,6 +32,10 @@ std::ostream& operator<<(std::ostream& os, const XmmRegister& reg) {
   return os << reg.AsFloatRegister();
 }
 
+std::ostream& operator<<(std::ostream& os, const YmmRegister& reg) {
+  return os << "YMM" << static_cast<int>(reg.AsFloatRegister());
+}
+
 std::ostream& operator<<(std::ostream& os, const X87Register& reg) {
   return os << "ST" << static_cast<int>(reg);
 }
@@ -3691,6 +3695,930 @@ void X86_64Assembler::psrldq(XmmRegister reg, const Immediate& shift_count) {
   EmitUint8(shift_count.value());
 }
 
+void X86_64Assembler::vzeroupper() {
+  DCHECK(CpuHasAVXorAVX2FeatureFlag());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  X86_64ManagedRegister vvvv_reg = ManagedRegister::NoRegister().AsX86_64();
+  EmitUint8(EmitVexPrefixByteZero(/*is_twobyte_form=*/ true));
+  EmitUint8(EmitVexPrefixByteOne(/*R=*/ false, vvvv_reg, SET_VEX_L_128, SET_VEX_PP_NONE));
+  EmitUint8(0x77);
+}
+
+void X86_64Assembler::vmovdqa(YmmRegister dst, const Address& src) {
+  EmitVex256AddressOperation(0x6F, SET_VEX_M_0F, SET_VEX_PP_66, dst.AsFloatRegister(), src);
+}
+
+void X86_64Assembler::vmovdqa(const Address& dst, YmmRegister src) {
+  EmitVex256AddressOperation(0x7F, SET_VEX_M_0F, SET_VEX_PP_66, src.AsFloatRegister(), dst);
+}
+
+void X86_64Assembler::vmovdqu(YmmRegister dst, const Address& src) {
+  EmitVex256AddressOperation(0x6F, SET_VEX_M_0F, SET_VEX_PP_F3, dst.AsFloatRegister(), src);
+}
+
+void X86_64Assembler::vmovdqu(const Address& dst, YmmRegister src) {
+  EmitVex256AddressOperation(0x7F, SET_VEX_M_0F, SET_VEX_PP_F3, src.AsFloatRegister(), dst);
+}
+
+void X86_64Assembler::vmovaps(YmmRegister dst, const Address& src) {
+  EmitVex256AddressOperation(0x28, SET_VEX_M_0F, SET_VEX_PP_NONE, dst.AsFloatRegister(), src);
+}
+
+void X86_64Assembler::vmovaps(const Address& dst, YmmRegister src) {
+  EmitVex256AddressOperation(0x29, SET_VEX_M_0F, SET_VEX_PP_NONE, src.AsFloatRegister(), dst);
+}
+
+void X86_64Assembler::vmovups(YmmRegister dst, const Address& src) {
+  EmitVex256AddressOperation(0x10, SET_VEX_M_0F, SET_VEX_PP_NONE, dst.AsFloatRegister(), src);
+}
+
+void X86_64Assembler::vmovups(const Address& dst, YmmRegister src) {
+  EmitVex256AddressOperation(0x11, SET_VEX_M_0F, SET_VEX_PP_NONE, src.AsFloatRegister(), dst);
+}
+
+void X86_64Assembler::vmovapd(YmmRegister dst, const Address& src) {
+  EmitVex256AddressOperation(0x28, SET_VEX_M_0F, SET_VEX_PP_66, dst.AsFloatRegister(), src);
+}
+
+void X86_64Assembler::vmovapd(const Address& dst, YmmRegister src) {
+  EmitVex256AddressOperation(0x29, SET_VEX_M_0F, SET_VEX_PP_66, src.AsFloatRegister(), dst);
+}
+
+void X86_64Assembler::vmovupd(YmmRegister dst, const Address& src) {
+  EmitVex256AddressOperation(0x10, SET_VEX_M_0F, SET_VEX_PP_66, dst.AsFloatRegister(), src);
+}
+
+void X86_64Assembler::vmovupd(const Address& dst, YmmRegister src) {
+  EmitVex256AddressOperation(0x11, SET_VEX_M_0F, SET_VEX_PP_66, src.AsFloatRegister(), dst);
+}
+
+void X86_64Assembler::vmovaps(YmmRegister dst, YmmRegister src) {
+  EmitVex256RegisterOperation(0x28,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpabsb(YmmRegister dst, YmmRegister src) {
+  EmitVex256RegisterOperation(0x1C,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpabsw(YmmRegister dst, YmmRegister src) {
+  EmitVex256RegisterOperation(0x1D,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpabsd(YmmRegister dst, YmmRegister src) {
+  EmitVex256RegisterOperation(0x1E,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vcvtdq2ps(YmmRegister dst, YmmRegister src) {
+  EmitVex256RegisterOperation(0x5B,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastb(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x78,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastw(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x79,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastd(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x58,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpbroadcastq(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x59,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vbroadcastss(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x18,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vbroadcastsd(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x19,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmovzxbw(YmmRegister dst, XmmRegister src) {
+  EmitVex256RegisterOperation(0x30,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              src.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xFC,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xFD,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xFE,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xD4,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xF8,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xF9,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xFA,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubq(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xFB,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmullw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xD5,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmulld(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x40,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddusb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xDC,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xEC,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddusw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xDD,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpaddsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xED,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubusb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xD8,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xE8,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubusw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xD9,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsubsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xE9,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpavgb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xE0,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpavgw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xE3,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x38,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxsb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x3C,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xEA,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxsw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xEE,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminsd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x39,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxsd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x3D,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminub(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xDA,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxub(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xDE,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminuw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x3A,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxuw(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x3E,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpminud(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x3B,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaxud(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x3F,
+                              SET_VEX_M_0F_38,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpand(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xDB,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpandn(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xDF,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xEB,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpxor(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xEF,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpmaddwd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0xF5,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpeqb(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x74,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpcmpgtd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x66,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vaddps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x58,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vaddpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x58,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmulps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x59,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmulpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x59,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vsubps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5C,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vsubpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5C,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vminps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5D,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vminpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5D,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vdivps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5E,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vdivpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5E,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmaxps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5F,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vmaxpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x5F,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x54,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x54,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandnps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x55,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vandnpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x55,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x56,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x56,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vxorps(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x57,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_NONE,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vxorpd(YmmRegister dst, YmmRegister src1, YmmRegister src2) {
+  EmitVex256RegisterOperation(0x57,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              dst.LowBits(),
+                              dst.NeedsRex(),
+                              X86_64ManagedRegister::FromXmmRegister(src1.AsFloatRegister()),
+                              src2.AsFloatRegister());
+}
+
+void X86_64Assembler::vpsllw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x71,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 6,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpslld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x72,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 6,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsllq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x73,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 6,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsraw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x71,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 4,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrad(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x72,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 4,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrlw(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x71,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 2,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrld(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x72,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 2,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vpsrlq(YmmRegister dst, YmmRegister src, const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  EmitVex256RegisterOperation(0x73,
+                              SET_VEX_M_0F,
+                              SET_VEX_PP_66,
+                              /*reg=*/ 2,
+                              /*reg_needs_rex=*/ false,
+                              X86_64ManagedRegister::FromXmmRegister(dst.AsFloatRegister()),
+                              src.AsFloatRegister());
+  EmitUint8(shift_count.value());
+}
+
+void X86_64Assembler::vextracti128(XmmRegister dst, YmmRegister src, const Immediate& imm) {
+  DCHECK(imm.is_uint8());
+  EmitVex256RegisterOperation(0x39,
+                              SET_VEX_M_0F_3A,
+                              SET_VEX_PP_66,
+                              src.LowBits(),
+                              src.NeedsRex(),
+                              ManagedRegister::NoRegister().AsX86_64(),
+                              dst.AsFloatRegister());
+  EmitUint8(imm.value());
+}
+
+void X86_64Assembler::EmitVex256RegisterOperation(uint8_t opcode,
+                                                  int vex_m,
+                                                  int vex_pp,
+                                                  uint8_t reg,
+                                                  bool reg_needs_rex,
+                                                  X86_64ManagedRegister vvvv,
+                                                  FloatRegister rm) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  bool rm_needs_rex = rm > 7;
+  // The two byte form can only encode the 0F opcode map and no REX.B/X/W bits.
+  bool is_twobyte_form = (vex_m == SET_VEX_M_0F) && !rm_needs_rex;
+  EmitUint8(EmitVexPrefixByteZero(is_twobyte_form));
+  if (is_twobyte_form) {
+    EmitUint8(EmitVexPrefixByteOne(reg_needs_rex, vvvv, SET_VEX_L_256, vex_pp));
+  } else {
+    EmitUint8(EmitVexPrefixByteOne(reg_needs_rex, /*X=*/ false, rm_needs_rex, vex_m));
+    EmitUint8(vvvv.IsNoRegister()
+                  ? EmitVexPrefixByteTwo(/*W=*/ false, SET_VEX_L_256, vex_pp)
+                  : EmitVexPrefixByteTwo(/*W=*/ false, vvvv, SET_VEX_L_256, vex_pp));
+  }
+  EmitUint8(opcode);
+  EmitRegisterOperand(reg, static_cast<uint8_t>(rm));
+}
+
+void X86_64Assembler::EmitVex256AddressOperation(uint8_t opcode,
+                                                 int vex_m,
+                                                 int vex_pp,
+                                                 FloatRegister reg,
+                                                 const Address& address) {
+  DCHECK(has_AVX2_);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  uint8_t rex = address.rex();
+  bool rex_x = rex & GET_REX_X;
+  bool rex_b = rex & GET_REX_B;
+  bool reg_needs_rex = reg > 7;
+  bool is_twobyte_form = (vex_m == SET_VEX_M_0F) && !rex_x && !rex_b;
+  EmitUint8(EmitVexPrefixByteZero(is_twobyte_form));
+  if (is_twobyte_form) {
+    X86_64ManagedRegister vvvv_reg = ManagedRegister::NoRegister().AsX86_64();
+    EmitUint8(EmitVexPrefixByteOne(reg_needs_rex, vvvv_reg, SET_VEX_L_256, vex_pp));
+  } else {
+    EmitUint8(EmitVexPrefixByteOne(reg_needs_rex, rex_x, rex_b, vex_m));
+    EmitUint8(EmitVexPrefixByteTwo(/*W=*/ false, SET_VEX_L_256, vex_pp));
+  }
+  EmitUint8(opcode);
+  EmitOperand(reg & 7, address);
+}
+
 
 void X86_64Assembler::fldl(const Address& src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
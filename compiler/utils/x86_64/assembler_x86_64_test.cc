@@ -2112,6 +2112,78 @@ TEST_F(AssemblerX86_64Test, Psrldq) {
             "psrldq $2, %xmm15\n", "psrldqi");
 }
 
+TEST_F(AssemblerX86_64AVXTest, VPadddYmm) {
+  GetAssembler()->vpaddd(x86_64::YmmRegister(x86_64::XMM0),
+                         x86_64::YmmRegister(x86_64::XMM1),
+                         x86_64::YmmRegister(x86_64::XMM2));
+  GetAssembler()->vpaddd(x86_64::YmmRegister(x86_64::XMM8),
+                         x86_64::YmmRegister(x86_64::XMM9),
+                         x86_64::YmmRegister(x86_64::XMM15));
+  DriverStr("vpaddd %ymm2, %ymm1, %ymm0\n"
+            "vpaddd %ymm15, %ymm9, %ymm8\n", "vpaddd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPminsdYmm) {
+  GetAssembler()->vpminsd(x86_64::YmmRegister(x86_64::XMM3),
+                          x86_64::YmmRegister(x86_64::XMM12),
+                          x86_64::YmmRegister(x86_64::XMM5));
+  DriverStr("vpminsd %ymm5, %ymm12, %ymm3\n", "vpminsd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMulpsYmm) {
+  GetAssembler()->vmulps(x86_64::YmmRegister(x86_64::XMM1),
+                         x86_64::YmmRegister(x86_64::XMM2),
+                         x86_64::YmmRegister(x86_64::XMM11));
+  DriverStr("vmulps %ymm11, %ymm2, %ymm1\n", "vmulps_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VMovdquYmm) {
+  GetAssembler()->vmovdqu(x86_64::YmmRegister(x86_64::XMM0),
+                          x86_64::Address(x86_64::CpuRegister(x86_64::RDI),
+                                          x86_64::CpuRegister(x86_64::RAX),
+                                          x86_64::TIMES_4,
+                                          12));
+  GetAssembler()->vmovdqu(x86_64::Address(x86_64::CpuRegister(x86_64::R8),
+                                          x86_64::CpuRegister(x86_64::R9),
+                                          x86_64::TIMES_1,
+                                          16),
+                          x86_64::YmmRegister(x86_64::XMM10));
+  DriverStr("vmovdqu 0xc(%rdi,%rax,4), %ymm0\n"
+            "vmovdqu %ymm10, 0x10(%r8,%r9,1)\n", "vmovdqu_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPslldYmm) {
+  GetAssembler()->vpslld(x86_64::YmmRegister(x86_64::XMM0),
+                         x86_64::YmmRegister(x86_64::XMM1),
+                         x86_64::Immediate(3));
+  GetAssembler()->vpsrlq(x86_64::YmmRegister(x86_64::XMM14),
+                         x86_64::YmmRegister(x86_64::XMM13),
+                         x86_64::Immediate(1));
+  DriverStr("vpslld $3, %ymm1, %ymm0\n"
+            "vpsrlq $1, %ymm13, %ymm14\n", "vpslld_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VPbroadcastdYmm) {
+  GetAssembler()->vpbroadcastd(x86_64::YmmRegister(x86_64::XMM0),
+                               x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vbroadcastss(x86_64::YmmRegister(x86_64::XMM9),
+                               x86_64::XmmRegister(x86_64::XMM9));
+  DriverStr("vpbroadcastd %xmm1, %ymm0\n"
+            "vbroadcastss %xmm9, %ymm9\n", "vpbroadcastd_ymm");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VExtracti128) {
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM0),
+                               x86_64::YmmRegister(x86_64::XMM12),
+                               x86_64::Immediate(1));
+  DriverStr("vextracti128 $1, %ymm12, %xmm0\n", "vextracti128");
+}
+
+TEST_F(AssemblerX86_64AVXTest, VZeroupper) {
+  GetAssembler()->vzeroupper();
+  DriverStr("vzeroupper\n", "vzeroupper");
+}
+
 std::string x87_fn(AssemblerX86_64Test::Base* assembler_test ATTRIBUTE_UNUSED,
                    x86_64::X86_64Assembler* assembler) {
   std::ostringstream str;
@@ -1130,6 +1130,12 @@ DISASSEMBLER_ENTRY(cmp,
         has_modrm = true;
         load = true;
         break;
+      case 0xC0: case 0xC1:
+        opcode1 = "xadd";
+        has_modrm = true;
+        store = true;
+        byte_operand = (*instr == 0xC0);
+        break;
       case 0xC3:
         opcode1 = "movnti";
         store = true;
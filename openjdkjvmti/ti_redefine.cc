@@ -119,6 +119,7 @@
 #include "runtime_globals.h"
 #include "scoped_thread_state_change.h"
 #include "stack.h"
+#include "stack_trace_element_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 #include "ti_breakpoint.h"
@@ -2496,6 +2497,9 @@ jvmtiError Redefiner::Run() {
       }
       redef.UpdateClass(data);
     }
+    // Redefined methods keep their ArtMethod* when updated in place, but their stack trace
+    // elements may have different line numbers and source files.
+    runtime_->GetStackTraceElementCache()->Clear(self_);
     RestoreObsoleteMethodMapsIfUnneeded(holder);
     // TODO We should check for if any of the redefined methods are intrinsic methods here and, if
     // any are, force a full-world deoptimization before finishing redefinition. If we don't do this
@@ -2922,10 +2926,11 @@ void Redefiner::ClassRedefinition::UpdateClassStructurally(const RedefinitionDat
     // TODO We might be able to avoid doing this but given the rather unstructured nature of the
     // interpreter cache it's probably not worth the effort.
     art::MutexLock mu(driver_->self_, *art::Locks::thread_list_lock_);
-    driver_->runtime_->GetThreadList()->ForEach(
-        [](art::Thread* t) { t->GetInterpreterCache()->Clear(t); });
+    driver_->runtime_->GetThreadList()->ForEach([](art::Thread* t) {
+      t->GetInterpreterCache()->Clear(t);
+      t->GetCatchHandlerCache()->Clear();
+    });
   }
-
   if (art::kIsDebugBuild) {
     // Just make sure we didn't screw up any of the now obsolete methods or fields. We need their
     // declaring-class to still be the obolete class
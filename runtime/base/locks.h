@@ -74,6 +74,7 @@ enum LockLevel : uint8_t {
   kRosAllocBulkFreeLock,
   kAllocSpaceLock,
   kTaggingLockLevel,
+  kStackTraceElementCacheLock,
   kTransactionLogLock,
   kCustomTlsLock,
   kJniFunctionTableLock,
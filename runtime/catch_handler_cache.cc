@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch_handler_cache.h"
+
+#include "gc_root-inl.h"
+#include "runtime.h"
+
+namespace art {
+
+bool CatchHandlerCache::Get(const Instruction* inst,
+                            ObjPtr<mirror::Class> exception_class,
+                            /* out */ uint32_t* handler_dex_pc,
+                            /* out */ bool* clear_exception) {
+  const Entry& entry = entries_[IndexOf(inst, exception_class)];
+  if (entry.inst == inst && entry.exception_class.Read() == exception_class) {
+    *handler_dex_pc = entry.handler_dex_pc;
+    *clear_exception = entry.clear_exception;
+    return true;
+  }
+  return false;
+}
+
+void CatchHandlerCache::Set(const Instruction* inst,
+                            ObjPtr<mirror::Class> exception_class,
+                            uint32_t handler_dex_pc,
+                            bool clear_exception) {
+  entries_[IndexOf(inst, exception_class)] =
+      Entry{inst, GcRoot<mirror::Class>(exception_class), handler_dex_pc, clear_exception};
+}
+
+void CatchHandlerCache::Sweep(IsMarkedVisitor* visitor) {
+  for (Entry& entry : entries_) {
+    if (entry.inst == nullptr) {
+      continue;
+    }
+    Runtime::ProcessWeakClass(&entry.exception_class, visitor, /* update= */ nullptr);
+    if (entry.exception_class.IsNull()) {
+      // The class has been unloaded.
+      entry = Entry{};
+    }
+  }
+}
+
+}  // namespace art
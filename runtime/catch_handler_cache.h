@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_CATCH_HANDLER_CACHE_H_
+#define ART_RUNTIME_CATCH_HANDLER_CACHE_H_
+
+#include <array>
+
+#include "base/bit_utils.h"
+#include "base/locks.h"
+#include "base/macros.h"
+#include "gc_root.h"
+#include "obj_ptr.h"
+
+namespace art {
+
+class Instruction;
+class IsMarkedVisitor;
+
+namespace mirror {
+class Class;
+}  // namespace mirror
+
+// Small thread-local cache of catch block lookups done when delivering exceptions.
+// It maps a throwing dex instruction and an exception class to the dex pc of the catch
+// handler for it, or dex::kDexNoIndex if the method does not catch the exception there.
+// All operations must be done from the owning thread, or at a point when the owning
+// thread is suspended.
+//
+// Like the InterpreterCache, it is keyed by dex instruction pointer and is cleared
+// whenever a dex file is unloaded or classes are redefined. The exception classes are
+// weak roots swept by the GC.
+class CatchHandlerCache {
+ public:
+  static constexpr size_t kSize = 64;
+
+  CatchHandlerCache() {
+    entries_.fill(Entry{});
+  }
+
+  bool Get(const Instruction* inst,
+           ObjPtr<mirror::Class> exception_class,
+           /* out */ uint32_t* handler_dex_pc,
+           /* out */ bool* clear_exception) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  void Set(const Instruction* inst,
+           ObjPtr<mirror::Class> exception_class,
+           uint32_t handler_dex_pc,
+           bool clear_exception) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  void Clear() {
+    entries_.fill(Entry{});
+  }
+
+  // Update moved exception classes and drop the entries of unloaded ones.
+  void Sweep(IsMarkedVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_);
+
+ private:
+  struct Entry {
+    const Instruction* inst = nullptr;
+    GcRoot<mirror::Class> exception_class;
+    uint32_t handler_dex_pc = 0u;
+    bool clear_exception = false;
+  };
+
+  static ALWAYS_INLINE size_t IndexOf(const Instruction* inst,
+                                      ObjPtr<mirror::Class> exception_class) {
+    static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
+    uintptr_t hash = (reinterpret_cast<uintptr_t>(inst) >> 1) ^
+                     (reinterpret_cast<uintptr_t>(exception_class.Ptr()) >> 3);
+    return hash & (kSize - 1);
+  }
+
+  std::array<Entry, kSize> entries_;
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_CATCH_HANDLER_CACHE_H_
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch_handler_cache.h"
+
+#include <vector>
+
+#include "class_linker.h"
+#include "common_runtime_test.h"
+#include "dex/dex_file_types.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+
+class CatchHandlerCacheTest : public CommonRuntimeTest {};
+
+TEST_F(CatchHandlerCacheTest, GetSetClear) {
+  ScopedObjectAccess soa(Thread::Current());
+  ObjPtr<mirror::Class> npe =
+      class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/NullPointerException;");
+  ObjPtr<mirror::Class> error = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Error;");
+  ASSERT_TRUE(npe != nullptr);
+  ASSERT_TRUE(error != nullptr);
+
+  std::vector<uint16_t> code(2);
+  const Instruction* inst1 = reinterpret_cast<const Instruction*>(&code[0]);
+  const Instruction* inst2 = reinterpret_cast<const Instruction*>(&code[1]);
+
+  CatchHandlerCache cache;
+  uint32_t handler_dex_pc = 0u;
+  bool clear_exception = false;
+  EXPECT_FALSE(cache.Get(inst1, npe, &handler_dex_pc, &clear_exception));
+
+  cache.Set(inst1, npe, 5u, /* clear_exception= */ true);
+  cache.Set(inst2, npe, dex::kDexNoIndex, /* clear_exception= */ false);
+  EXPECT_TRUE(cache.Get(inst1, npe, &handler_dex_pc, &clear_exception));
+  EXPECT_EQ(5u, handler_dex_pc);
+  EXPECT_TRUE(clear_exception);
+  // Negative results are cached too.
+  EXPECT_TRUE(cache.Get(inst2, npe, &handler_dex_pc, &clear_exception));
+  EXPECT_EQ(dex::kDexNoIndex, handler_dex_pc);
+  EXPECT_FALSE(clear_exception);
+  // Entries are specific to the exception class.
+  EXPECT_FALSE(cache.Get(inst1, error, &handler_dex_pc, &clear_exception));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get(inst1, npe, &handler_dex_pc, &clear_exception));
+  EXPECT_FALSE(cache.Get(inst2, npe, &handler_dex_pc, &clear_exception));
+}
+
+}  // namespace art
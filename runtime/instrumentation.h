@@ -348,6 +348,10 @@ class Instrumentation {
     return instrumentation_stubs_installed_;
   }
 
+  bool EntryExitStubsInstalled() const {
+    return entry_exit_stubs_installed_;
+  }
+
   bool HasMethodEntryListeners() const REQUIRES_SHARED(Locks::mutator_lock_) {
     return have_method_entry_listeners_;
   }
@@ -396,6 +400,16 @@ class Instrumentation {
         have_exception_handled_listeners_;
   }
 
+  // Returns whether there are listeners for events that are reported only by the switch
+  // interpreter. Exception thrown events are reported by the exception delivery, for nterp
+  // frames as well as for compiled code. Method entry, exit and unwind events need the
+  // entry/exit stubs, see EntryExitStubsInstalled().
+  bool HasInterpreterOnlyListeners() const REQUIRES_SHARED(Locks::mutator_lock_) {
+    return have_dex_pc_listeners_ || have_field_read_listeners_ || have_field_write_listeners_ ||
+        have_branch_listeners_ || have_watched_frame_pop_listeners_ ||
+        have_exception_handled_listeners_;
+  }
+
   // Inform listeners that a method has been entered. A dex PC is provided as we may install
   // listeners into executing code and get method enter events for methods already on the stack.
   void MethodEnterEvent(Thread* thread,
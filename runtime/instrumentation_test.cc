@@ -494,6 +494,40 @@ TEST_F(InstrumentationTest, NoInstrumentation) {
   EXPECT_FALSE(instr->HasMethodEntryListeners());
   EXPECT_FALSE(instr->HasMethodExitListeners());
   EXPECT_FALSE(instr->IsActive());
+  EXPECT_FALSE(instr->HasInterpreterOnlyListeners());
+}
+
+TEST_F(InstrumentationTest, InterpreterOnlyListeners) {
+  ScopedObjectAccess soa(Thread::Current());
+  instrumentation::Instrumentation* instr = Runtime::Current()->GetInstrumentation();
+  TestInstrumentationListener listener;
+  constexpr uint32_t kStubEvents = instrumentation::Instrumentation::kMethodEntered |
+                                   instrumentation::Instrumentation::kMethodExited |
+                                   instrumentation::Instrumentation::kMethodUnwind |
+                                   instrumentation::Instrumentation::kExceptionThrown;
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ScopedSuspendAll ssa("Add instrumentation listener");
+    instr->AddListener(&listener, kStubEvents);
+  }
+  EXPECT_TRUE(instr->IsActive());
+  EXPECT_FALSE(instr->HasInterpreterOnlyListeners());
+
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ScopedSuspendAll ssa("Add instrumentation listener");
+    instr->AddListener(&listener, instrumentation::Instrumentation::kDexPcMoved);
+  }
+  EXPECT_TRUE(instr->HasInterpreterOnlyListeners());
+
+  {
+    ScopedThreadSuspension sts(soa.Self(), kSuspended);
+    ScopedSuspendAll ssa("Remove instrumentation listener");
+    instr->RemoveListener(&listener,
+                          kStubEvents | instrumentation::Instrumentation::kDexPcMoved);
+  }
+  EXPECT_FALSE(instr->IsActive());
+  EXPECT_FALSE(instr->HasInterpreterOnlyListeners());
 }
 
 // Test instrumentation listeners for each event.
@@ -23,6 +23,15 @@ void InterpreterCache::Clear(Thread* owning_thread) {
   DCHECK(owning_thread->GetInterpreterCache() == this);
   DCHECK(owning_thread == Thread::Current() || owning_thread->IsSuspended());
   data_.fill(Entry{});
+  if (second_level_ != nullptr) {
+    second_level_->fill(Entry{});
+  }
+}
+
+void InterpreterCache::AllocateSecondLevel() {
+  DCHECK(second_level_ == nullptr);
+  second_level_.reset(new std::array<Entry, kSecondLevelSize>());
+  second_level_->fill(Entry{});
 }
 
 bool InterpreterCache::IsCalledFromOwningThread() {
@@ -19,6 +19,7 @@
 
 #include <array>
 #include <atomic>
+#include <memory>
 
 #include "base/bit_utils.h"
 #include "base/macros.h"
@@ -42,6 +43,11 @@ class Thread;
 // We ensure consistency of the cache by clearing it
 // whenever any dex file is unloaded.
 //
+// Field and method lookups, which do not hold GC roots, can also be stored in a larger
+// second-level cache. It is allocated the first time such a store conflicts with another
+// entry of the main cache, and it is only consulted from the runtime on a main cache miss.
+// It is cleared together with the main cache.
+//
 // Aligned to 16-bytes to make it easier to get the address of the cache
 // from assembly (it ensures that the offset is valid immediate value).
 class ALIGNED(16) InterpreterCache {
@@ -81,9 +87,56 @@ class ALIGNED(16) InterpreterCache {
     return data_;
   }
 
+  // Size of the second-level cache.
+  static constexpr size_t kSecondLevelSize = 1024;
+
+  // Look up `key` in the second-level cache, and copy a hit into the main cache.
+  ALWAYS_INLINE bool GetFromSecondLevel(const void* key, /* out */ size_t* value) {
+    DCHECK(IsCalledFromOwningThread());
+    if (second_level_ == nullptr) {
+      return false;
+    }
+    Entry& entry = (*second_level_)[SecondLevelIndexOf(key)];
+    if (entry.first == key) {
+      ++second_level_hits_;
+      *value = entry.second;
+      Set(key, entry.second);
+      return true;
+    }
+    ++second_level_misses_;
+    return false;
+  }
+
+  // Like Set(), but also store the entry in the second-level cache. The value must not
+  // be a GC root.
+  ALWAYS_INLINE void SetWithSecondLevel(const void* key, size_t value) {
+    DCHECK(IsCalledFromOwningThread());
+    if (UNLIKELY(second_level_ == nullptr)) {
+      const void* current_key = data_[IndexOf(key)].first;
+      if (current_key == nullptr || current_key == key) {
+        Set(key, value);
+        return;
+      }
+      AllocateSecondLevel();
+    }
+    (*second_level_)[SecondLevelIndexOf(key)] = Entry{key, value};
+    Set(key, value);
+  }
+
+  // Second-level hit and miss counts, logged at thread exit with `-verbose:interpreter`.
+  uint64_t GetSecondLevelHits() const {
+    return second_level_hits_;
+  }
+
+  uint64_t GetSecondLevelMisses() const {
+    return second_level_misses_;
+  }
+
  private:
   bool IsCalledFromOwningThread();
 
+  void AllocateSecondLevel();
+
   static ALWAYS_INLINE size_t IndexOf(const void* key) {
     static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
     size_t index = (reinterpret_cast<uintptr_t>(key) >> 2) & (kSize - 1);
@@ -91,7 +144,20 @@ class ALIGNED(16) InterpreterCache {
     return index;
   }
 
+  static ALWAYS_INLINE size_t SecondLevelIndexOf(const void* key) {
+    static_assert(IsPowerOfTwo(kSecondLevelSize), "Size must be power of two");
+    static_assert(kSecondLevelSize > kSize, "Second level must be larger than the main cache");
+    size_t index = (reinterpret_cast<uintptr_t>(key) >> 2) & (kSecondLevelSize - 1);
+    DCHECK_LT(index, kSecondLevelSize);
+    return index;
+  }
+
   std::array<Entry, kSize> data_;
+
+  // Fields below are not accessed by the assembly interpreters.
+  std::unique_ptr<std::array<Entry, kSecondLevelSize>> second_level_;
+  uint64_t second_level_hits_ = 0u;
+  uint64_t second_level_misses_ = 0u;
 };
 
 }  // namespace art
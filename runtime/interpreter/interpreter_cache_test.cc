@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interpreter_cache.h"
+
+#include <vector>
+
+#include "common_runtime_test.h"
+#include "thread-current-inl.h"
+
+namespace art {
+
+class InterpreterCacheTest : public CommonRuntimeTest {};
+
+TEST_F(InterpreterCacheTest, SecondLevel) {
+  Thread* self = Thread::Current();
+  InterpreterCache* cache = self->GetInterpreterCache();
+  cache->Clear(self);
+
+  // Two keys that map to the same entry of the main cache but not of the second level.
+  std::vector<uint32_t> buffer(2 * InterpreterCache::kSize);
+  const void* key1 = &buffer[0];
+  const void* key2 = &buffer[InterpreterCache::kSize];
+  size_t value = 0u;
+
+  // Without a conflict, only the main cache is used.
+  cache->SetWithSecondLevel(key1, 1u);
+  EXPECT_TRUE(cache->Get(key1, &value));
+  EXPECT_EQ(1u, value);
+
+  // A conflict replaces the main cache entry and also stores into the second level.
+  cache->SetWithSecondLevel(key2, 2u);
+  EXPECT_FALSE(cache->Get(key1, &value));
+  EXPECT_TRUE(cache->Get(key2, &value));
+  EXPECT_EQ(2u, value);
+
+  uint64_t hits = cache->GetSecondLevelHits();
+  uint64_t misses = cache->GetSecondLevelMisses();
+  EXPECT_FALSE(cache->GetFromSecondLevel(key1, &value));
+  EXPECT_EQ(misses + 1u, cache->GetSecondLevelMisses());
+
+  cache->SetWithSecondLevel(key1, 1u);
+  EXPECT_FALSE(cache->Get(key2, &value));
+  EXPECT_TRUE(cache->GetFromSecondLevel(key2, &value));
+  EXPECT_EQ(2u, value);
+  EXPECT_EQ(hits + 1u, cache->GetSecondLevelHits());
+  // A second-level hit refills the main cache.
+  EXPECT_TRUE(cache->Get(key2, &value));
+  EXPECT_EQ(2u, value);
+
+  cache->Clear(self);
+  EXPECT_FALSE(cache->Get(key2, &value));
+  EXPECT_FALSE(cache->GetFromSecondLevel(key1, &value));
+  EXPECT_FALSE(cache->GetFromSecondLevel(key2, &value));
+}
+
+}  // namespace art
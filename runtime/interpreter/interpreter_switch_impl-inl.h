@@ -1858,6 +1858,75 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
       << "Entered interpreter from invoke without retry instruction being handled!";
 
   bool const interpret_one_instruction = ctx->interpret_one_instruction;
+#ifdef ART_USE_THREADED_INTERPRETER
+  // Threaded dispatch: every opcode handler ends with its own indirect jump to the next
+  // handler, which gives the branch predictor one dispatch site per opcode instead of
+  // the single shared jump of the switch below.
+  static const void* const kHandlerLabels[] = {
+#define OPCODE_LABEL(OPCODE, OPCODE_NAME, NAME, FORMAT, i, a, e, v) &&OPCODE_NAME##_HANDLER,
+    DEX_INSTRUCTION_LIST(OPCODE_LABEL)
+#undef OPCODE_LABEL
+  };
+  static_assert(arraysize(kHandlerLabels) == Instruction::kNumPackedOpcodes);
+
+  const Instruction* inst;
+  uint16_t inst_data;
+  bool exit = false;
+  bool success;
+
+#define DISPATCH_NEXT()                                                                           \
+  do {                                                                                            \
+    inst = next;                                                                                  \
+    dex_pc = inst->GetDexPc(insns);                                                               \
+    shadow_frame.SetDexPC(dex_pc);                                                                \
+    TraceExecution(shadow_frame, inst, dex_pc);                                                   \
+    inst_data = inst->Fetch16(0);                                                                 \
+    if (!InstructionHandler<do_access_check, transaction_active, Instruction::kInvalidFormat>(    \
+            ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit).       \
+            Preamble()) {                                                                         \
+      goto HANDLER_EPILOGUE;                                                                      \
+    }                                                                                             \
+    DCHECK_EQ(self->IsExceptionPending(), inst->Opcode(inst_data) == Instruction::MOVE_EXCEPTION);\
+    goto *kHandlerLabels[inst->Opcode(inst_data)];                                                \
+  } while (false)
+
+  DISPATCH_NEXT();
+
+#define OPCODE_LABEL(OPCODE, OPCODE_NAME, NAME, FORMAT, i, a, e, v)                               \
+  OPCODE_NAME##_HANDLER: {                                                                        \
+    next = inst->RelativeAt(Instruction::SizeInCodeUnits(Instruction::FORMAT));                   \
+    success = OP_##OPCODE_NAME<do_access_check, transaction_active>(                              \
+        ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit);           \
+    if (success && LIKELY(!interpret_one_instruction)) {                                          \
+      DISPATCH_NEXT();                                                                            \
+    }                                                                                             \
+    goto HANDLER_EPILOGUE;                                                                        \
+  }
+  DEX_INSTRUCTION_LIST(OPCODE_LABEL)
+#undef OPCODE_LABEL
+
+HANDLER_EPILOGUE:
+  if (exit) {
+    shadow_frame.SetDexPC(dex::kDexNoIndex);
+    return;  // Return statement or debugger forced exit.
+  }
+  if (self->IsExceptionPending()) {
+    if (!InstructionHandler<do_access_check, transaction_active, Instruction::kInvalidFormat>(
+            ctx, instrumentation, self, shadow_frame, dex_pc, inst, inst_data, next, exit).
+            HandlePendingException()) {
+      shadow_frame.SetDexPC(dex::kDexNoIndex);
+      return;  // Locally unhandled exception - return to caller.
+    }
+    // Continue execution in the catch block.
+  }
+  if (interpret_one_instruction) {
+    shadow_frame.SetDexPC(next->GetDexPc(insns));  // Record where we stopped.
+    ctx->result = ctx->result_register;
+    return;
+  }
+  DISPATCH_NEXT();
+#undef DISPATCH_NEXT
+#else  // ART_USE_THREADED_INTERPRETER
   while (true) {
     const Instruction* const inst = next;
     dex_pc = inst->GetDexPc(insns);
@@ -1904,6 +1973,7 @@ void ExecuteSwitchImplCpp(SwitchImplContext* ctx) {
       return;
     }
   }
+#endif  // ART_USE_THREADED_INTERPRETER
 }  // NOLINT(readability/fn_size)
 
 }  // namespace interpreter
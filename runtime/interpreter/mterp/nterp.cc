@@ -45,7 +45,11 @@ bool CanRuntimeUseNterp() REQUIRES_SHARED(Locks::mutator_lock_) {
   return IsNterpSupported() &&
       !instr->InterpretOnly() &&
       !runtime->IsAotCompiler() &&
-      !runtime->GetInstrumentation()->IsActive() &&
+      // With the entry/exit stubs installed, method entry, exit and frame pop events are
+      // reported by the switch interpreter for interpreted frames.
+      !instr->EntryExitStubsInstalled() &&
+      // Other events, except exception thrown, are only reported by the switch interpreter.
+      !instr->HasInterpreterOnlyListeners() &&
       // nterp only knows how to deal with the normal exits. It cannot handle any of the
       // non-standard force-returns.
       !runtime->AreNonStandardExitsEnabled() &&
@@ -119,6 +123,27 @@ inline void UpdateCache(Thread* self, uint16_t* dex_pc_ptr, T* value) {
   UpdateCache(self, dex_pc_ptr, reinterpret_cast<size_t>(value));
 }
 
+// Field and method lookups are also stored in the second-level cache, which survives
+// conflicts in the direct-mapped thread cache.
+template<typename T>
+inline void UpdateCacheWithSecondLevel(Thread* self, uint16_t* dex_pc_ptr, T value) {
+  DCHECK(kUseReadBarrier) << "Nterp only works with read barriers";
+  if (self->GetWeakRefAccessEnabled()) {
+    self->GetInterpreterCache()->SetWithSecondLevel(dex_pc_ptr, value);
+  }
+}
+
+template<typename T>
+inline void UpdateCacheWithSecondLevel(Thread* self, uint16_t* dex_pc_ptr, T* value) {
+  UpdateCacheWithSecondLevel(self, dex_pc_ptr, reinterpret_cast<size_t>(value));
+}
+
+inline bool FindInSecondLevelCache(Thread* self, uint16_t* dex_pc_ptr, size_t* value) {
+  // Looking up also refills the main cache, so check the same condition as UpdateCache.
+  return self->GetWeakRefAccessEnabled() &&
+      self->GetInterpreterCache()->GetFromSecondLevel(dex_pc_ptr, value);
+}
+
 #ifdef __arm__
 
 extern "C" void NterpStoreArm32Fprs(const char* shorty,
@@ -267,6 +292,10 @@ extern "C" const char* NterpGetShortyFromInvokeCustom(ArtMethod* caller, uint16_
 extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (FindInSecondLevelCache(self, dex_pc_ptr, &cached_value)) {
+    return cached_value;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   InvokeType invoke_type = kStatic;
   uint16_t method_index = 0;
@@ -401,7 +430,7 @@ extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, uint16_t* dex_
         result = reinterpret_cast<size_t>(resolved_method);
       }
     }
-    UpdateCache(self, dex_pc_ptr, result);
+    UpdateCacheWithSecondLevel(self, dex_pc_ptr, result);
     return result;
   } else if (resolved_method->GetDeclaringClass()->IsStringClass()
              && !resolved_method->IsStatic()
@@ -414,10 +443,10 @@ extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, uint16_t* dex_
     // calls.
     return reinterpret_cast<size_t>(resolved_method) | 1;
   } else if (invoke_type == kVirtual) {
-    UpdateCache(self, dex_pc_ptr, resolved_method->GetMethodIndex());
+    UpdateCacheWithSecondLevel(self, dex_pc_ptr, resolved_method->GetMethodIndex());
     return resolved_method->GetMethodIndex();
   } else {
-    UpdateCache(self, dex_pc_ptr, resolved_method);
+    UpdateCacheWithSecondLevel(self, dex_pc_ptr, resolved_method);
     return reinterpret_cast<size_t>(resolved_method);
   }
 }
@@ -476,6 +505,10 @@ extern "C" size_t NterpGetStaticField(Thread* self,
                                       size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (FindInSecondLevelCache(self, dex_pc_ptr, &cached_value)) {
+    return cached_value;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegB_21c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -508,7 +541,7 @@ extern "C" size_t NterpGetStaticField(Thread* self,
     // check for it.
     return reinterpret_cast<size_t>(resolved_field) | 1;
   } else {
-    UpdateCache(self, dex_pc_ptr, resolved_field);
+    UpdateCacheWithSecondLevel(self, dex_pc_ptr, resolved_field);
     return reinterpret_cast<size_t>(resolved_field);
   }
 }
@@ -519,6 +552,10 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
                                                 size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (FindInSecondLevelCache(self, dex_pc_ptr, &cached_value)) {
+    return static_cast<uint32_t>(cached_value);
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegC_22c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -539,7 +576,7 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
     // of volatile.
     return -resolved_field->GetOffset().Uint32Value();
   }
-  UpdateCache(self, dex_pc_ptr, resolved_field->GetOffset().Uint32Value());
+  UpdateCacheWithSecondLevel(self, dex_pc_ptr, resolved_field->GetOffset().Uint32Value());
   return resolved_field->GetOffset().Uint32Value();
 }
 
@@ -32,6 +32,7 @@
 #include "runtime.h"
 #include "thread-current-inl.h"
 #include "thread.h"
+#include "thread_pool.h"
 
 #include <atomic>
 #include <cstddef>
@@ -108,6 +109,9 @@ constexpr uint32_t kJitRepackGroupSize = 64 * KB;
 // Automatically call the repack method every 'n' new entries.
 constexpr uint32_t kJitRepackFrequency = 64;
 
+// Repack synchronously if the background repack task has not run after this many new entries.
+constexpr uint32_t kJitRepackSyncThreshold = 4 * kJitRepackFrequency;
+
 // Public binary interface between ART and native tools (gdb, libunwind, etc).
 // The fields below need to be exported and have special names as per the gdb api.
 extern "C" {
@@ -211,6 +215,9 @@ static std::vector<const void*> g_removed_jit_functions GUARDED_BY(g_jit_debug_l
 // Number of small (single symbol) ELF files. Used to trigger repacking.
 static uint32_t g_jit_num_unpacked_entries = 0;
 
+// Whether a repack task has been added to the JIT thread pool and has not run yet.
+static bool g_jit_repack_task_pending GUARDED_BY(g_jit_debug_lock) = false;
+
 struct DexNativeInfo {
   static constexpr bool kCopySymfileData = false;  // Just reference DEX files.
   static JITDescriptor& Descriptor() { return __dex_debug_descriptor; }
@@ -480,6 +487,8 @@ void NativeDebugInfoPostFork() {
   CHECK(!Runtime::Current()->IsZygote());
   JITDescriptor& descriptor = JitNativeInfo::Descriptor();
   descriptor.free_entries_ = nullptr;  // Don't reuse zygote's entries.
+  MutexLock mu(Thread::Current(), g_jit_debug_lock);
+  g_jit_repack_task_pending = false;  // The zygote's thread pool tasks are not inherited.
 }
 
 // Split the JIT code cache into groups of fixed size and create single JITCodeEntry for each group.
@@ -567,10 +576,23 @@ static void RepackEntries(bool compress_entries, ArrayRef<const void*> removed)
 
 void RepackNativeDebugInfoForJitLocked() REQUIRES(g_jit_debug_lock);
 
-void AddNativeDebugInfoForJit(const void* code_ptr,
-                              const std::vector<uint8_t>& symfile,
-                              bool allow_packing) {
-  MutexLock mu(Thread::Current(), g_jit_debug_lock);
+// Pack recent entries on the JIT thread pool, outside of the critical section which commits
+// the compiled code. This runs after the compilations which are already queued.
+static void RepackEntriesTask(Thread* self) {
+  MutexLock mu(self, *Locks::jit_lock_);  // Needed to alloc entries.
+  MutexLock mu2(self, g_jit_debug_lock);
+  g_jit_repack_task_pending = false;
+  // The entries might have been repacked by the JIT GC in the meantime.
+  if (g_jit_num_unpacked_entries >= kJitRepackFrequency) {
+    bool is_zygote = Runtime::Current()->IsZygote();
+    RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+  }
+}
+
+// Returns the thread pool to which a repack task should be added, if any.
+static ThreadPool* AddNativeDebugInfoForJitLocked(const void* code_ptr,
+                                                  const std::vector<uint8_t>& symfile,
+                                                  bool allow_packing) REQUIRES(g_jit_debug_lock) {
   DCHECK_NE(symfile.size(), 0u);
   if (kIsDebugBuild && code_ptr != nullptr) {
     DCHECK(g_dcheck_all_jit_functions.insert(code_ptr).second) << code_ptr << " already added";
@@ -597,9 +619,35 @@ void AddNativeDebugInfoForJit(const void* code_ptr,
   // Pack (but don't compress) recent entries - this is cheap and reduces memory use by ~4x.
   // We delay compression until after GC since it is more expensive (and saves further ~4x).
   // Always compress zygote, since it does not GC and we want to keep the high-water mark low.
+  // The packing is done in the background, unless the JIT thread pool falls behind.
   if (++g_jit_num_unpacked_entries >= kJitRepackFrequency) {
-    bool is_zygote = Runtime::Current()->IsZygote();
-    RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+    jit::Jit* jit = Runtime::Current()->GetJit();
+    ThreadPool* thread_pool = (jit != nullptr) ? jit->GetThreadPool() : nullptr;
+    if (thread_pool != nullptr && g_jit_num_unpacked_entries < kJitRepackSyncThreshold) {
+      if (!g_jit_repack_task_pending) {
+        g_jit_repack_task_pending = true;
+        return thread_pool;
+      }
+    } else {
+      bool is_zygote = Runtime::Current()->IsZygote();
+      RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+    }
+  }
+  return nullptr;
+}
+
+void AddNativeDebugInfoForJit(const void* code_ptr,
+                              const std::vector<uint8_t>& symfile,
+                              bool allow_packing) {
+  Thread* self = Thread::Current();
+  ThreadPool* thread_pool = nullptr;
+  {
+    MutexLock mu(self, g_jit_debug_lock);
+    thread_pool = AddNativeDebugInfoForJitLocked(code_ptr, symfile, allow_packing);
+  }
+  // The task queue lock must not be acquired while holding g_jit_debug_lock.
+  if (thread_pool != nullptr) {
+    thread_pool->AddTask(self, new FunctionTask(RepackEntriesTask));
   }
 }
 
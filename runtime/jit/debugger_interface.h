@@ -51,6 +51,7 @@ void RemoveNativeDebugInfoForDex(Thread* self, const DexFile* dexfile);
 // The method will make copy of the passed ELF file (to shrink it to the minimum size).
 // If packing is allowed, the ELF file might be merged with others to save space
 // (however, this drops all ELF sections other than symbols names and unwinding info).
+// The packing is usually deferred to a task on the JIT thread pool.
 void AddNativeDebugInfoForJit(const void* code_ptr,
                               const std::vector<uint8_t>& symfile,
                               bool allow_packing)
@@ -26,6 +26,7 @@
 #include "base/memory_tool.h"
 #include "base/runtime_debug.h"
 #include "base/scoped_flock.h"
+#include "base/time_utils.h"
 #include "base/utils.h"
 #include "class_root-inl.h"
 #include "compilation_kind.h"
@@ -198,11 +199,24 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
   return jit_options;
 }
 
+static void PrintCompileTime(std::ostream& os, const Histogram<uint64_t>& histogram) {
+  os << histogram.Name();
+  if (histogram.SampleSize() != 0u) {
+    os << ": Avg: " << PrettyDuration(static_cast<uint64_t>(histogram.Mean()))
+       << " Max: " << PrettyDuration(histogram.Max())
+       << " Min: " << PrettyDuration(histogram.Min()) << "\n";
+  } else {
+    os << ": <no data>\n";
+  }
+}
+
 void Jit::DumpInfo(std::ostream& os) {
   code_cache_->Dump(os);
   cumulative_timings_.Dump(os);
   MutexLock mu(Thread::Current(), lock_);
   memory_use_.PrintMemoryUse(os);
+  PrintCompileTime(os, baseline_compile_time_);
+  PrintCompileTime(os, optimized_compile_time_);
 }
 
 void Jit::DumpForSigQuit(std::ostream& os) {
@@ -220,6 +234,8 @@ Jit::Jit(JitCodeCache* code_cache, JitOptions* options)
       boot_completed_lock_("Jit::boot_completed_lock_"),
       cumulative_timings_("JIT timings"),
       memory_use_("Memory used for compilation", 16),
+      baseline_compile_time_("Baseline compilation time per code unit", 100),
+      optimized_compile_time_("Optimized compilation time per code unit", 100),
       lock_("JIT memory use lock"),
       zygote_mapping_methods_(),
       fd_methods_(-1),
@@ -634,6 +650,21 @@ void Jit::AddMemoryUsage(ArtMethod* method, size_t bytes) {
   memory_use_.AddValue(bytes);
 }
 
+void Jit::AddCompilationTime(ArtMethod* method, CompilationKind kind, uint64_t duration_ns) {
+  size_t code_units = method->DexInstructions().InsnsSizeInCodeUnits();
+  if (code_units == 0u) {
+    // Native methods have no dex instructions.
+    return;
+  }
+  uint64_t time_per_code_unit = duration_ns / code_units;
+  MutexLock mu(Thread::Current(), lock_);
+  if (kind == CompilationKind::kBaseline) {
+    baseline_compile_time_.AddValue(time_per_code_unit);
+  } else {
+    optimized_compile_time_.AddValue(time_per_code_unit);
+  }
+}
+
 void Jit::NotifyZygoteCompilationDone() {
   if (fd_methods_ == -1) {
     return;
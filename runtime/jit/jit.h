@@ -277,6 +277,11 @@ class Jit {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record the time it took to compile `method`, normalized by its number of dex code units.
+  void AddCompilationTime(ArtMethod* method, CompilationKind kind, uint64_t duration_ns)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   int GetThreadPoolPthreadPriority() const {
     return options_->GetThreadPoolPthreadPriority();
   }
@@ -505,6 +510,10 @@ class Jit {
   // Performance monitoring.
   CumulativeLogger cumulative_timings_;
   Histogram<uint64_t> memory_use_ GUARDED_BY(lock_);
+  // Compilation time per dex code unit, in nanoseconds. OSR compilations are counted as
+  // optimized ones.
+  Histogram<uint64_t> baseline_compile_time_ GUARDED_BY(lock_);
+  Histogram<uint64_t> optimized_compile_time_ GUARDED_BY(lock_);
   Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
   // In the JIT zygote configuration, after all compilation is done, the zygote
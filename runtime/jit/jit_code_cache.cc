@@ -56,6 +56,7 @@
 #include "profile/profile_compilation_info.h"
 #include "scoped_thread_state_change-inl.h"
 #include "stack.h"
+#include "stack_walk_cache.h"
 #include "thread-current-inl.h"
 #include "thread_list.h"
 
@@ -999,6 +1000,8 @@ void JitCodeCache::Free(Thread* self,
 }
 
 void JitCodeCache::FreeLocked(JitMemoryRegion* region, const uint8_t* code, const uint8_t* data) {
+  // The memory may be reused for other code, so stack walks must not use what they cached for it.
+  StackWalkCache::InvalidateAll();
   if (code != nullptr) {
     RemoveNativeDebugInfoForJit(reinterpret_cast<const void*>(FromAllocationToCode(code)));
     region->FreeCode(code);
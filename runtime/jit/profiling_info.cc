@@ -64,13 +64,21 @@ ProfilingInfo* ProfilingInfo::Create(Thread* self, ArtMethod* method) {
   return code_cache->AddProfilingInfo(self, method, entries);
 }
 
-InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
+InlineCache* ProfilingInfo::FindInlineCache(uint32_t dex_pc) {
   // TODO: binary search if array is too long.
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
     if (cache_[i].dex_pc_ == dex_pc) {
       return &cache_[i];
     }
   }
+  return nullptr;
+}
+
+InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
+  InlineCache* cache = FindInlineCache(dex_pc);
+  if (cache != nullptr) {
+    return cache;
+  }
   ScopedObjectAccess soa(Thread::Current());
   LOG(FATAL) << "No inline cache found for "  << ArtMethod::PrettyMethod(method_) << "@" << dex_pc;
   UNREACHABLE();
@@ -82,6 +82,9 @@ class ProfilingInfo {
 
   InlineCache* GetInlineCache(uint32_t dex_pc);
 
+  // Like GetInlineCache, but returns null if there is no inline cache for `dex_pc`.
+  InlineCache* FindInlineCache(uint32_t dex_pc);
+
   // Increments the number of times this method is currently being inlined.
   // Returns whether it was successful, that is it could increment without
   // overflowing.
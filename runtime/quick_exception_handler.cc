@@ -107,9 +107,7 @@ class CatchBlockStackVisitor final : public StackVisitor {
     }
     if (dex_pc != dex::kDexNoIndex) {
       bool clear_exception = false;
-      StackHandleScope<1> hs(GetThread());
-      Handle<mirror::Class> to_find(hs.NewHandle((*exception_)->GetClass()));
-      uint32_t found_dex_pc = method->FindCatchBlock(to_find, dex_pc, &clear_exception);
+      uint32_t found_dex_pc = FindCatchBlock(method, dex_pc, &clear_exception);
       exception_handler_->SetClearException(clear_exception);
       if (found_dex_pc != dex::kDexNoIndex) {
         exception_handler_->SetHandlerDexPc(found_dex_pc);
@@ -133,6 +131,29 @@ class CatchBlockStackVisitor final : public StackVisitor {
     return true;  // Continue stack walk.
   }
 
+  // Find the catch block with ArtMethod::FindCatchBlock(), going through the thread's
+  // catch handler cache when weak references can be read.
+  uint32_t FindCatchBlock(ArtMethod* method, uint32_t dex_pc, /* out */ bool* clear_exception)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    Thread* self = GetThread();
+    ObjPtr<mirror::Class> exception_class = (*exception_)->GetClass();
+    const Instruction* inst = &method->DexInstructions().InstructionAt(dex_pc);
+    CatchHandlerCache* cache = self->GetCatchHandlerCache();
+    uint32_t found_dex_pc = dex::kDexNoIndex;
+    // The cache holds the exception classes as weak roots.
+    bool use_cache = self->GetWeakRefAccessEnabled();
+    if (use_cache && cache->Get(inst, exception_class, &found_dex_pc, clear_exception)) {
+      return found_dex_pc;
+    }
+    StackHandleScope<1> hs(self);
+    Handle<mirror::Class> to_find(hs.NewHandle(exception_class));
+    found_dex_pc = method->FindCatchBlock(to_find, dex_pc, clear_exception);
+    if (use_cache && self->GetWeakRefAccessEnabled()) {
+      cache->Set(inst, to_find.Get(), found_dex_pc, *clear_exception);
+    }
+    return found_dex_pc;
+  }
+
   // The exception we're looking for the catch block of.
   Handle<mirror::Throwable>* exception_;
   // The quick exception handler we're visiting for.
@@ -163,6 +163,7 @@
 #include "sigchain.h"
 #include "signal_catcher.h"
 #include "signal_set.h"
+#include "stack_trace_element_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 #include "ti/agent.h"
@@ -1462,6 +1463,9 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   monitor_pool_ = MonitorPool::Create();
   thread_list_ = new ThreadList(runtime_options.GetOrDefault(Opt::ThreadSuspendTimeout));
   intern_table_ = new InternTable;
+  stack_trace_element_cache_.reset(new StackTraceElementCache());
+  // No GC can be running yet, so we do not need to go through AddSystemWeakHolder().
+  system_weak_holders_.push_back(stack_trace_element_cache_.get());
 
   monitor_timeout_enable_ = runtime_options.GetOrDefault(Opt::MonitorTimeoutEnable);
   int monitor_timeout_ms = runtime_options.GetOrDefault(Opt::MonitorTimeout);
@@ -108,6 +108,7 @@ struct RuntimeArgumentMap;
 class RuntimeCallbacks;
 class SignalCatcher;
 class StackOverflowHandler;
+class StackTraceElementCache;
 class SuspensionHandler;
 class ThreadList;
 class ThreadPool;
@@ -345,6 +346,10 @@ class Runtime {
     return intern_table_;
   }
 
+  StackTraceElementCache* GetStackTraceElementCache() const {
+    return stack_trace_element_cache_.get();
+  }
+
   JavaVMExt* GetJavaVM() const {
     return java_vm_.get();
   }
@@ -1194,6 +1199,8 @@ class Runtime {
 
   InternTable* intern_table_;
 
+  std::unique_ptr<StackTraceElementCache> stack_trace_element_cache_;
+
   ClassLinker* class_linker_;
 
   SignalCatcher* signal_catcher_;
@@ -44,6 +44,7 @@
 #include "obj_ptr-inl.h"
 #include "quick/quick_method_frame_info.h"
 #include "runtime.h"
+#include "stack_walk_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 
@@ -53,6 +54,9 @@ using android::base::StringPrintf;
 
 static constexpr bool kDebugStackWalk = false;
 
+// Whether stack walks use the StackWalkCache of the walking thread.
+static constexpr bool kUseStackWalkCache = true;
+
 StackVisitor::StackVisitor(Thread* thread,
                            Context* context,
                            StackWalkKind walk_kind,
@@ -74,6 +78,9 @@ StackVisitor::StackVisitor(Thread* thread,
       cur_depth_(0),
       cur_inline_info_(nullptr, CodeInfo()),
       cur_stack_map_(0, StackMap()),
+      stack_walk_cache_(kUseStackWalkCache && Thread::Current() != nullptr
+                            ? Thread::Current()->GetStackWalkCache()
+                            : nullptr),
       context_(context),
       check_suspended_(check_suspended) {
   if (check_suspended_) {
@@ -85,7 +92,10 @@ CodeInfo* StackVisitor::GetCurrentInlineInfo() const {
   DCHECK(!(*cur_quick_frame_)->IsNative());
   const OatQuickMethodHeader* header = GetCurrentOatQuickMethodHeader();
   if (cur_inline_info_.first != header) {
-    cur_inline_info_ = std::make_pair(header, CodeInfo::DecodeInlineInfoOnly(header));
+    cur_inline_info_ = std::make_pair(header,
+                                      stack_walk_cache_ != nullptr
+                                          ? stack_walk_cache_->GetCodeInfo(header)
+                                          : CodeInfo::DecodeInlineInfoOnly(header));
   }
   return &cur_inline_info_.second;
 }
@@ -94,9 +104,19 @@ StackMap* StackVisitor::GetCurrentStackMap() const {
   DCHECK(!(*cur_quick_frame_)->IsNative());
   const OatQuickMethodHeader* header = GetCurrentOatQuickMethodHeader();
   if (cur_stack_map_.first != cur_quick_frame_pc_) {
-    uint32_t pc = header->NativeQuickPcOffset(cur_quick_frame_pc_);
-    cur_stack_map_ = std::make_pair(cur_quick_frame_pc_,
-                                    GetCurrentInlineInfo()->GetStackMapForNativePcOffset(pc));
+    CodeInfo* code_info = GetCurrentInlineInfo();
+    uint32_t row;
+    if (stack_walk_cache_ != nullptr &&
+        stack_walk_cache_->GetStackMapRow(header, cur_quick_frame_pc_, &row)) {
+      cur_stack_map_ = std::make_pair(cur_quick_frame_pc_, code_info->GetStackMapAt(row));
+    } else {
+      uint32_t pc = header->NativeQuickPcOffset(cur_quick_frame_pc_);
+      StackMap stack_map = code_info->GetStackMapForNativePcOffset(pc);
+      if (stack_walk_cache_ != nullptr && stack_map.IsValid()) {
+        stack_walk_cache_->SetStackMapRow(header, cur_quick_frame_pc_, stack_map.Row());
+      }
+      cur_stack_map_ = std::make_pair(cur_quick_frame_pc_, stack_map);
+    }
   }
   return &cur_stack_map_.second;
 }
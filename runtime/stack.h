@@ -38,6 +38,7 @@ class Context;
 class HandleScope;
 class OatQuickMethodHeader;
 class ShadowFrame;
+class StackWalkCache;
 class Thread;
 union JValue;
 
@@ -368,6 +369,9 @@ class StackVisitor {
   mutable std::pair<const OatQuickMethodHeader*, CodeInfo> cur_inline_info_;
   mutable std::pair<uintptr_t, StackMap> cur_stack_map_;
 
+  // The cache of the walking thread, used to avoid decoding the same code info on every walk.
+  StackWalkCache* const stack_walk_cache_;
+
  protected:
   Context* const context_;
   const bool check_suspended_;
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_trace_element_cache.h"
+
+#include <algorithm>
+
+#include "art_method-inl.h"
+#include "base/casts.h"
+#include "gc_root-inl.h"
+#include "mirror/class.h"
+#include "mirror/stack_trace_element.h"
+#include "runtime.h"
+
+namespace art {
+
+ObjPtr<mirror::StackTraceElement> StackTraceElementCache::Lookup(Thread* self,
+                                                                 ArtMethod* method,
+                                                                 uint32_t dex_pc) {
+  MutexLock mu(self, allow_disallow_lock_);
+  Wait(self);
+  auto it = entries_.find(Key(method, dex_pc));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return it->second.element.Read();
+}
+
+void StackTraceElementCache::Add(Thread* self,
+                                 ArtMethod* method,
+                                 uint32_t dex_pc,
+                                 ObjPtr<mirror::StackTraceElement> element) {
+  DCHECK(element != nullptr);
+  ObjPtr<mirror::Class> declaring_class = method->GetDeclaringClass();
+  Entry entry{GcRoot<mirror::Class>(declaring_class), GcRoot<mirror::StackTraceElement>(element)};
+  Key key(method, dex_pc);
+  MutexLock mu(self, allow_disallow_lock_);
+  Wait(self);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    // Another thread added an element for the same frame.
+    it->second = entry;
+    return;
+  }
+  if (entries_.size() >= kMaxEntries) {
+    DCHECK(!insertion_order_.empty());
+    entries_.erase(insertion_order_.front());
+    insertion_order_.pop_front();
+  }
+  entries_.emplace(key, entry);
+  insertion_order_.push_back(key);
+  DCHECK_EQ(entries_.size(), insertion_order_.size());
+}
+
+void StackTraceElementCache::Clear(Thread* self) {
+  MutexLock mu(self, allow_disallow_lock_);
+  entries_.clear();
+  insertion_order_.clear();
+}
+
+size_t StackTraceElementCache::Size(Thread* self) {
+  MutexLock mu(self, allow_disallow_lock_);
+  return entries_.size();
+}
+
+void StackTraceElementCache::Sweep(IsMarkedVisitor* visitor) {
+  MutexLock mu(Thread::Current(), allow_disallow_lock_);
+  size_t old_size = entries_.size();
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    Entry& entry = it->second;
+    // Drop the entries of unloaded classes, as their methods are freed.
+    Runtime::ProcessWeakClass(&entry.declaring_class, visitor, /* update= */ nullptr);
+    mirror::Object* element = nullptr;
+    if (!entry.declaring_class.IsNull()) {
+      // This does not need a read barrier because this is called by GC.
+      element = visitor->IsMarked(entry.element.Read<kWithoutReadBarrier>());
+    }
+    if (element == nullptr) {
+      it = entries_.erase(it);
+    } else {
+      entry.element =
+          GcRoot<mirror::StackTraceElement>(down_cast<mirror::StackTraceElement*>(element));
+      ++it;
+    }
+  }
+  if (entries_.size() != old_size) {
+    // Keep `insertion_order_` in sync so that it holds each key of `entries_` once.
+    insertion_order_.erase(
+        std::remove_if(insertion_order_.begin(),
+                       insertion_order_.end(),
+                       [this](const Key& key) REQUIRES(allow_disallow_lock_) {
+                         return entries_.find(key) == entries_.end();
+                       }),
+        insertion_order_.end());
+  }
+  DCHECK_EQ(entries_.size(), insertion_order_.size());
+}
+
+}  // namespace art
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_STACK_TRACE_ELEMENT_CACHE_H_
+#define ART_RUNTIME_STACK_TRACE_ELEMENT_CACHE_H_
+
+#include <deque>
+#include <unordered_map>
+#include <utility>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "gc/system_weak.h"
+#include "gc_root.h"
+#include "obj_ptr.h"
+
+namespace art {
+
+class ArtMethod;
+
+namespace mirror {
+class Class;
+class StackTraceElement;
+}  // namespace mirror
+
+// Cache of the StackTraceElement objects created for (method, dex pc) pairs when
+// converting internal stack traces, so that repeated Throwable.getStackTrace() calls
+// on the same frames do not decode debug info and allocate strings again.
+//
+// StackTraceElement objects are immutable, so they can be shared between traces. They
+// are weak roots of the cache. Entries are also dropped when the declaring class of
+// the method is unloaded, and the whole cache is cleared when classes are redefined.
+//
+// Sharing is visible to Java code: the same (method, dex pc) frame in two stack traces
+// may now be the same StackTraceElement object, where it used to be two equal ones.
+// libcore does not rely on identity here. StackTraceElement is final, has no setters,
+// and implements equals() and hashCode() by value. Throwable.getStackTrace() already
+// returns copies of one array sharing the same elements, so callers cannot assume
+// distinct elements anyway.
+class StackTraceElementCache final : public gc::SystemWeakHolder {
+ public:
+  // When the cache holds this number of entries, adding one evicts the oldest entry.
+  static constexpr size_t kMaxEntries = 8192;
+
+  // The lock level must be above kMarkSweepMarkStackLock, as Lookup() reads the cached
+  // element with a read barrier while holding the lock.
+  StackTraceElementCache() : gc::SystemWeakHolder(kStackTraceElementCacheLock) {}
+
+  ObjPtr<mirror::StackTraceElement> Lookup(Thread* self, ArtMethod* method, uint32_t dex_pc)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!allow_disallow_lock_);
+
+  void Add(Thread* self,
+           ArtMethod* method,
+           uint32_t dex_pc,
+           ObjPtr<mirror::StackTraceElement> element)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!allow_disallow_lock_);
+
+  void Clear(Thread* self) REQUIRES(!allow_disallow_lock_);
+
+  size_t Size(Thread* self) REQUIRES(!allow_disallow_lock_);
+
+  void Sweep(IsMarkedVisitor* visitor) override
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!allow_disallow_lock_);
+
+ private:
+  using Key = std::pair<ArtMethod*, uint32_t>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<ArtMethod*>()(key.first) * 31u + key.second;
+    }
+  };
+
+  struct Entry {
+    GcRoot<mirror::Class> declaring_class;
+    GcRoot<mirror::StackTraceElement> element;
+  };
+
+  std::unordered_map<Key, Entry, KeyHash> entries_ GUARDED_BY(allow_disallow_lock_);
+
+  // Keys of `entries_`, oldest first, for eviction.
+  std::deque<Key> insertion_order_ GUARDED_BY(allow_disallow_lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(StackTraceElementCache);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_STACK_TRACE_ELEMENT_CACHE_H_
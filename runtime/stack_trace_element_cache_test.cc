@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_trace_element_cache.h"
+
+#include "class_linker.h"
+#include "common_runtime_test.h"
+#include "handle_scope-inl.h"
+#include "mirror/class-inl.h"
+#include "mirror/stack_trace_element.h"
+#include "mirror/string.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+
+class StackTraceElementCacheTest : public CommonRuntimeTest {};
+
+TEST_F(StackTraceElementCacheTest, AddLookupClear) {
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  ObjPtr<mirror::Class> klass = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  ASSERT_TRUE(klass != nullptr);
+  ArtMethod* method = klass->FindClassMethod("hashCode", "()I", kRuntimePointerSize);
+  ASSERT_TRUE(method != nullptr);
+  Handle<mirror::String> name =
+      hs.NewHandle(mirror::String::AllocFromModifiedUtf8(soa.Self(), "Object.java"));
+  Handle<mirror::StackTraceElement> element = hs.NewHandle(
+      mirror::StackTraceElement::Alloc(soa.Self(), name, name, name, /* line_number= */ 42));
+  ASSERT_TRUE(element != nullptr);
+
+  StackTraceElementCache cache;
+  EXPECT_TRUE(cache.Lookup(soa.Self(), method, 0u) == nullptr);
+  cache.Add(soa.Self(), method, 0u, element.Get());
+  EXPECT_EQ(1u, cache.Size(soa.Self()));
+  EXPECT_EQ(element.Get(), cache.Lookup(soa.Self(), method, 0u));
+  // Entries are specific to the dex pc.
+  EXPECT_TRUE(cache.Lookup(soa.Self(), method, 1u) == nullptr);
+
+  cache.Clear(soa.Self());
+  EXPECT_EQ(0u, cache.Size(soa.Self()));
+  EXPECT_TRUE(cache.Lookup(soa.Self(), method, 0u) == nullptr);
+}
+
+TEST_F(StackTraceElementCacheTest, EvictOldest) {
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  ObjPtr<mirror::Class> klass = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Object;");
+  ASSERT_TRUE(klass != nullptr);
+  ArtMethod* method = klass->FindClassMethod("hashCode", "()I", kRuntimePointerSize);
+  ASSERT_TRUE(method != nullptr);
+  Handle<mirror::String> name =
+      hs.NewHandle(mirror::String::AllocFromModifiedUtf8(soa.Self(), "Object.java"));
+  Handle<mirror::StackTraceElement> element = hs.NewHandle(
+      mirror::StackTraceElement::Alloc(soa.Self(), name, name, name, /* line_number= */ 42));
+  ASSERT_TRUE(element != nullptr);
+
+  StackTraceElementCache cache;
+  constexpr uint32_t kMaxEntries = StackTraceElementCache::kMaxEntries;
+  for (uint32_t dex_pc = 0u; dex_pc != kMaxEntries; ++dex_pc) {
+    cache.Add(soa.Self(), method, dex_pc, element.Get());
+  }
+  EXPECT_EQ(kMaxEntries, cache.Size(soa.Self()));
+  // Adding an existing frame does not evict anything.
+  cache.Add(soa.Self(), method, 0u, element.Get());
+  EXPECT_EQ(kMaxEntries, cache.Size(soa.Self()));
+  EXPECT_EQ(element.Get(), cache.Lookup(soa.Self(), method, 0u));
+
+  // Adding a new frame to a full cache only evicts the oldest entry.
+  cache.Add(soa.Self(), method, kMaxEntries, element.Get());
+  EXPECT_EQ(kMaxEntries, cache.Size(soa.Self()));
+  EXPECT_TRUE(cache.Lookup(soa.Self(), method, 0u) == nullptr);
+  EXPECT_EQ(element.Get(), cache.Lookup(soa.Self(), method, 1u));
+  EXPECT_EQ(element.Get(), cache.Lookup(soa.Self(), method, kMaxEntries));
+}
+
+}  // namespace art
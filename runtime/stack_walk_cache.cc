@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_walk_cache.h"
+
+#include "oat_quick_method_header.h"
+
+namespace art {
+
+std::atomic<uint32_t> StackWalkCache::generation_(0u);
+
+StackWalkCache::StackWalkCache()
+    : generation_seen_(generation_.load(std::memory_order_seq_cst)) {}
+
+const CodeInfo& StackWalkCache::GetCodeInfo(const OatQuickMethodHeader* header) {
+  DCHECK(header->IsOptimized());
+  FlushIfStale();
+  CodeInfoEntry& entry = code_infos_[IndexOf<kCodeInfoSize>(reinterpret_cast<uintptr_t>(header))];
+  if (entry.header != header) {
+    entry.header = header;
+    entry.code_info = CodeInfo::DecodeInlineInfoOnly(header);
+  }
+  return entry.code_info;
+}
+
+bool StackWalkCache::GetStackMapRow(const OatQuickMethodHeader* header,
+                                    uintptr_t pc,
+                                    /* out */ uint32_t* row) {
+  FlushIfStale();
+  const StackMapEntry& entry = stack_maps_[IndexOf<kStackMapSize>(pc)];
+  if (entry.pc == pc && entry.header == header) {
+    *row = entry.row;
+    return true;
+  }
+  return false;
+}
+
+void StackWalkCache::SetStackMapRow(const OatQuickMethodHeader* header,
+                                    uintptr_t pc,
+                                    uint32_t row) {
+  FlushIfStale();
+  stack_maps_[IndexOf<kStackMapSize>(pc)] = StackMapEntry{header, pc, row};
+}
+
+void StackWalkCache::Flush(uint32_t generation) {
+  code_infos_.fill(CodeInfoEntry{});
+  stack_maps_.fill(StackMapEntry{});
+  generation_seen_ = generation;
+}
+
+}  // namespace art
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_STACK_WALK_CACHE_H_
+#define ART_RUNTIME_STACK_WALK_CACHE_H_
+
+#include <array>
+#include <atomic>
+
+#include "base/bit_utils.h"
+#include "base/macros.h"
+#include "stack_map.h"
+
+namespace art {
+
+class OatQuickMethodHeader;
+
+// Thread-local cache of the CodeInfo decoded by stack walks, and of the stack maps found
+// for native pcs, so that repeated walks over the same compiled frames (GC root visiting,
+// exception delivery, stack traces) do not decode them again. It is only used by the
+// owning thread, for the stacks it walks.
+//
+// Entries are keyed by OatQuickMethodHeader, which can be reused for other code once JIT
+// code is freed or oat files are unloaded. Such events call InvalidateAll(), which bumps a
+// global generation, and caches of an older generation are flushed before being used.
+class StackWalkCache {
+ public:
+  static constexpr size_t kCodeInfoSize = 16;
+  static constexpr size_t kStackMapSize = 64;
+
+  StackWalkCache();
+
+  // Return the CodeInfo of `header`, as decoded by CodeInfo::DecodeInlineInfoOnly().
+  const CodeInfo& GetCodeInfo(const OatQuickMethodHeader* header);
+
+  // Get the row of the stack map of `header` for the native `pc`, if cached.
+  bool GetStackMapRow(const OatQuickMethodHeader* header, uintptr_t pc, /* out */ uint32_t* row);
+
+  void SetStackMapRow(const OatQuickMethodHeader* header, uintptr_t pc, uint32_t row);
+
+  // Must be called before compiled code is freed or unloaded.
+  static void InvalidateAll() {
+    generation_.fetch_add(1u, std::memory_order_seq_cst);
+  }
+
+ private:
+  struct CodeInfoEntry {
+    const OatQuickMethodHeader* header = nullptr;
+    CodeInfo code_info;
+  };
+
+  struct StackMapEntry {
+    const OatQuickMethodHeader* header = nullptr;
+    uintptr_t pc = 0u;
+    uint32_t row = 0u;
+  };
+
+  ALWAYS_INLINE void FlushIfStale() {
+    uint32_t generation = generation_.load(std::memory_order_seq_cst);
+    if (UNLIKELY(generation != generation_seen_)) {
+      Flush(generation);
+    }
+  }
+
+  void Flush(uint32_t generation);
+
+  template <size_t kSize>
+  static ALWAYS_INLINE size_t IndexOf(uintptr_t key) {
+    static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
+    return (key >> 2) & (kSize - 1);
+  }
+
+  uint32_t generation_seen_;
+  std::array<CodeInfoEntry, kCodeInfoSize> code_infos_;
+  std::array<StackMapEntry, kStackMapSize> stack_maps_;
+
+  static std::atomic<uint32_t> generation_;
+
+  DISALLOW_COPY_AND_ASSIGN(StackWalkCache);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_STACK_WALK_CACHE_H_
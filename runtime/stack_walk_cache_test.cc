@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_walk_cache.h"
+
+#include "common_runtime_test.h"
+
+namespace art {
+
+class StackWalkCacheTest : public CommonRuntimeTest {};
+
+TEST_F(StackWalkCacheTest, StackMapRows) {
+  StackWalkCache cache;
+  // The headers are only used as keys.
+  const OatQuickMethodHeader* header1 = reinterpret_cast<const OatQuickMethodHeader*>(0x1000);
+  const OatQuickMethodHeader* header2 = reinterpret_cast<const OatQuickMethodHeader*>(0x2000);
+  uint32_t row = 0u;
+  EXPECT_FALSE(cache.GetStackMapRow(header1, 0x1010u, &row));
+
+  cache.SetStackMapRow(header1, 0x1010u, 3u);
+  EXPECT_TRUE(cache.GetStackMapRow(header1, 0x1010u, &row));
+  EXPECT_EQ(3u, row);
+  EXPECT_FALSE(cache.GetStackMapRow(header2, 0x1010u, &row));
+  EXPECT_FALSE(cache.GetStackMapRow(header1, 0x1014u, &row));
+
+  // Freeing or unloading code flushes the cache.
+  StackWalkCache::InvalidateAll();
+  EXPECT_FALSE(cache.GetStackMapRow(header1, 0x1010u, &row));
+}
+
+}  // namespace art
@@ -106,8 +106,11 @@
 #include "scoped_disable_public_sdk_checker.h"
 #include "stack.h"
 #include "stack_map.h"
+#include "stack_trace_element_cache.h"
+#include "stack_walk_cache.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "trace.h"
 #include "verifier/method_verifier.h"
 #include "verify_object.h"
 #include "well_known_classes.h"
@@ -177,10 +180,12 @@ void Thread::InitTlsEntryPoints() {
     *it = reinterpret_cast<uintptr_t>(UnimplementedEntryPoint);
   }
   InitEntryPoints(&tlsPtr_.jni_entrypoints, &tlsPtr_.quick_entrypoints);
+  tls32_.alloc_entrypoints_instrumented = AreQuickAllocEntryPointsInstrumented();
 }
 
 void Thread::ResetQuickAllocEntryPointsForThread() {
   ResetQuickAllocEntryPoints(&tlsPtr_.quick_entrypoints);
+  tls32_.alloc_entrypoints_instrumented = AreQuickAllocEntryPointsInstrumented();
 }
 
 class DeoptimizationContextRecord {
@@ -2388,6 +2393,16 @@ void Thread::Destroy() {
   Thread* self = this;
   DCHECK_EQ(self, Thread::Current());
 
+  if (VLOG_IS_ON(interpreter)) {
+    const InterpreterCache* cache = GetInterpreterCache();
+    uint64_t hits = cache->GetSecondLevelHits();
+    uint64_t misses = cache->GetSecondLevelMisses();
+    if (hits + misses != 0u) {
+      VLOG(interpreter) << "Interpreter second-level cache for thread " << *tlsPtr_.name
+                        << ": " << hits << " hits, " << misses << " misses";
+    }
+  }
+
   if (tlsPtr_.jni_env != nullptr) {
     {
       ScopedObjectAccess soa(self);
@@ -2443,6 +2458,8 @@ void Thread::Destroy() {
   {
     ScopedObjectAccess soa(self);
     Runtime::Current()->GetHeap()->RevokeThreadLocalBuffers(this);
+    // If method tracing, write the events this thread has not written yet.
+    Trace::FlushThreadBuffer(this);
   }
   // Mark-stack revocation must be performed at the very end. No
   // checkpoint/flip-function or read-barrier should be called after this.
@@ -2490,6 +2507,7 @@ Thread::~Thread() {
   delete tlsPtr_.instrumentation_stack;
   delete tlsPtr_.name;
   delete tlsPtr_.deps_or_stack_trace_sample.stack_trace_sample;
+  delete method_trace_buffer_;
 
   Runtime::Current()->GetHeap()->AssertThreadLocalBuffersAreRevoked(this);
 
@@ -2912,7 +2930,7 @@ bool Thread::IsExceptionThrownByCurrentMethod(ObjPtr<mirror::Throwable> exceptio
   return count_visitor.GetDepth() == static_cast<uint32_t>(exception->GetStackDepth());
 }
 
-static ObjPtr<mirror::StackTraceElement> CreateStackTraceElement(
+static ObjPtr<mirror::StackTraceElement> AllocStackTraceElement(
     const ScopedObjectAccessAlreadyRunnable& soa,
     ArtMethod* method,
     uint32_t dex_pc) REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -2967,6 +2985,26 @@ static ObjPtr<mirror::StackTraceElement> CreateStackTraceElement(
                                           line_number);
 }
 
+static ObjPtr<mirror::StackTraceElement> CreateStackTraceElement(
+    const ScopedObjectAccessAlreadyRunnable& soa,
+    ArtMethod* method,
+    uint32_t dex_pc) REQUIRES_SHARED(Locks::mutator_lock_) {
+  Runtime* runtime = Runtime::Current();
+  if (runtime->IsAotCompiler()) {
+    return AllocStackTraceElement(soa, method, dex_pc);
+  }
+  // StackTraceElement objects are immutable, so share them between stack traces.
+  StackTraceElementCache* cache = runtime->GetStackTraceElementCache();
+  ObjPtr<mirror::StackTraceElement> element = cache->Lookup(soa.Self(), method, dex_pc);
+  if (element == nullptr) {
+    element = AllocStackTraceElement(soa, method, dex_pc);
+    if (element != nullptr) {
+      cache->Add(soa.Self(), method, dex_pc, element);
+    }
+  }
+  return element;
+}
+
 jobjectArray Thread::InternalStackTraceToStackTraceElementArray(
     const ScopedObjectAccessAlreadyRunnable& soa,
     jobject internal,
@@ -3412,6 +3450,10 @@ void Thread::DumpThreadOffset(std::ostream& os, uint32_t offset) {
   DO_THREAD_OFFSET(TopShadowFrameOffset<ptr_size>(), "top_shadow_frame")
   DO_THREAD_OFFSET(TopHandleScopeOffset<ptr_size>(), "top_handle_scope")
   DO_THREAD_OFFSET(ThreadSuspendTriggerOffset<ptr_size>(), "suspend_trigger")
+  DO_THREAD_OFFSET(ThreadLocalPosOffset<ptr_size>(), "thread_local_pos")
+  DO_THREAD_OFFSET(ThreadLocalEndOffset<ptr_size>(), "thread_local_end")
+  DO_THREAD_OFFSET(ThreadLocalObjectsOffset<ptr_size>(), "thread_local_objects")
+  DO_THREAD_OFFSET(AllocEntrypointsInstrumentedOffset<ptr_size>(), "alloc_entrypoints_instrumented")
 #undef DO_THREAD_OFFSET
 
 #define JNI_ENTRY_POINT_INFO(x) \
@@ -4415,10 +4457,21 @@ void Thread::SetReadBarrierEntrypoints() {
   UpdateReadBarrierEntrypoints(&tlsPtr_.quick_entrypoints, /* is_active=*/ true);
 }
 
+StackWalkCache* Thread::GetStackWalkCache() {
+  DCHECK_EQ(this, Thread::Current());
+  if (stack_walk_cache_ == nullptr) {
+    stack_walk_cache_.reset(new StackWalkCache());
+  }
+  return stack_walk_cache_.get();
+}
+
 void Thread::ClearAllInterpreterCaches() {
+  // Compiled code of the unloaded dex files is about to be freed as well.
+  StackWalkCache::InvalidateAll();
   static struct ClearInterpreterCacheClosure : Closure {
     void Run(Thread* thread) override {
       thread->GetInterpreterCache()->Clear(thread);
+      thread->GetCatchHandlerCache()->Clear();
     }
   } closure;
   Runtime::Current()->GetThreadList()->RunCheckpoint(&closure);
@@ -31,6 +31,7 @@
 #include "base/macros.h"
 #include "base/safe_map.h"
 #include "base/value_object.h"
+#include "catch_handler_cache.h"
 #include "entrypoints/jni/jni_entrypoints.h"
 #include "entrypoints/quick/quick_entrypoints.h"
 #include "handle.h"
@@ -97,9 +98,11 @@ class RootVisitor;
 class ScopedObjectAccessAlreadyRunnable;
 class ShadowFrame;
 class StackedShadowFrameRecord;
+class StackWalkCache;
 enum class SuspendReason : char;
 class Thread;
 class ThreadList;
+struct ThreadTraceBuffer;
 enum VisitRootFlags : uint8_t;
 
 // A piece of data that can be held in the CustomTls. The destructor will be called during thread
@@ -703,6 +706,13 @@ class Thread {
         OFFSETOF_MEMBER(tls_32bit_sized_values, state_and_flags));
   }
 
+  template<PointerSize pointer_size>
+  static constexpr ThreadOffset<pointer_size> AllocEntrypointsInstrumentedOffset() {
+    return ThreadOffset<pointer_size>(
+        OFFSETOF_MEMBER(Thread, tls32_) +
+        OFFSETOF_MEMBER(tls_32bit_sized_values, alloc_entrypoints_instrumented));
+  }
+
   template<PointerSize pointer_size>
   static constexpr ThreadOffset<pointer_size> IsGcMarkingOffset() {
     return ThreadOffset<pointer_size>(
@@ -1113,6 +1123,14 @@ class Thread {
     tls64_.trace_clock_base = clock_base;
   }
 
+  ThreadTraceBuffer* GetMethodTraceBuffer() const {
+    return method_trace_buffer_;
+  }
+
+  void SetMethodTraceBuffer(ThreadTraceBuffer* buffer) {
+    method_trace_buffer_ = buffer;
+  }
+
   BaseMutex* GetHeldMutex(LockLevel level) const {
     return tlsPtr_.held_mutexes[level];
   }
@@ -1328,7 +1346,14 @@ class Thread {
     return &interpreter_cache_;
   }
 
-  // Clear all thread-local interpreter caches.
+  CatchHandlerCache* GetCatchHandlerCache() {
+    return &catch_handler_cache_;
+  }
+
+  // Get the cache used by the stack walks done by this thread, allocating it if needed.
+  StackWalkCache* GetStackWalkCache();
+
+  // Clear all thread-local interpreter and catch handler caches.
   //
   // Since the caches are keyed by memory pointer to dex instructions, this must be
   // called when any dex code is unloaded (before different code gets loaded at the
@@ -1558,7 +1583,8 @@ class Thread {
           user_code_suspend_count(0),
           force_interpreter_count(0),
           make_visibly_initialized_counter(0),
-          define_class_counter(0) {}
+          define_class_counter(0),
+          alloc_entrypoints_instrumented(false) {}
 
     union StateAndFlags state_and_flags;
     static_assert(sizeof(union StateAndFlags) == sizeof(int32_t),
@@ -1652,6 +1678,11 @@ class Thread {
     // Counter for how many nested define-classes are ongoing in this thread. Used to allow waiting
     // for threads to be done with class-definition work.
     uint32_t define_class_counter;
+
+    // Mirrors whether the quick allocation entrypoints are instrumented. Compiled code that
+    // bump-allocates from the TLAB inline checks this and calls the (instrumented) entrypoint
+    // instead, so that allocation listeners and allocation tracking see every object.
+    bool32_t alloc_entrypoints_instrumented;
   } tls32_;
 
   struct PACKED(8) tls_64bit_sized_values {
@@ -1862,6 +1893,15 @@ class Thread {
   // Note that it is not in the packed struct, may not be accessed for cross compilation.
   uintptr_t poison_object_cookie_ = 0;
 
+  // Method trace events not yet written to the trace, or null if not method tracing.
+  ThreadTraceBuffer* method_trace_buffer_ = nullptr;
+
+  // Catch blocks found when delivering exceptions, keyed by the throwing dex instruction.
+  CatchHandlerCache catch_handler_cache_;
+
+  // Decoded code info of the compiled frames seen by the stack walks of this thread.
+  std::unique_ptr<StackWalkCache> stack_walk_cache_;
+
   // Pending extra checkpoints if checkpoint_function_ is already used.
   std::list<Closure*> checkpoint_overflow_ GUARDED_BY(Locks::thread_suspend_count_lock_);
 
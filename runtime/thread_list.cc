@@ -1413,6 +1413,7 @@ void ThreadList::SweepInterpreterCaches(IsMarkedVisitor* visitor) const {
   MutexLock mu(Thread::Current(), *Locks::thread_list_lock_);
   for (const auto& thread : list_) {
     thread->SweepInterpreterCache(visitor);
+    thread->GetCatchHandlerCache()->Sweep(visitor);
   }
 }
 
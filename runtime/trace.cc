@@ -23,6 +23,7 @@
 #include "android-base/stringprintf.h"
 
 #include "art_method-inl.h"
+#include "barrier.h"
 #include "base/casts.h"
 #include "base/enums.h"
 #include "base/os.h"
@@ -73,7 +74,6 @@ TraceClockSource Trace::default_clock_source_ = kDefaultTraceClockSource;
 
 Trace* volatile Trace::the_trace_ = nullptr;
 pthread_t Trace::sampling_pthread_ = 0U;
-std::unique_ptr<std::vector<ArtMethod*>> Trace::temp_stack_trace_;
 
 // The key identifying the tracer to update instrumentation.
 static constexpr const char* kTracerInstrumentationKey = "Tracer";
@@ -109,16 +109,6 @@ uint32_t Trace::EncodeTraceMethodAndAction(ArtMethod* method, TraceAction action
   return tmid;
 }
 
-std::vector<ArtMethod*>* Trace::AllocStackTrace() {
-  return (temp_stack_trace_.get() != nullptr)  ? temp_stack_trace_.release() :
-      new std::vector<ArtMethod*>();
-}
-
-void Trace::FreeStackTrace(std::vector<ArtMethod*>* stack_trace) {
-  stack_trace->clear();
-  temp_stack_trace_.reset(stack_trace);
-}
-
 void Trace::SetDefaultClockSource(TraceClockSource clock_source) {
 #if defined(__linux__)
   default_clock_source_ = clock_source;
@@ -204,23 +194,74 @@ static void Append8LE(uint8_t* buf, uint64_t val) {
   *buf++ = static_cast<uint8_t>(val >> 56);
 }
 
-static void GetSample(Thread* thread, void* arg) REQUIRES_SHARED(Locks::mutator_lock_) {
-  std::vector<ArtMethod*>* const stack_trace = Trace::AllocStackTrace();
-  StackVisitor::WalkStack(
-      [&](const art::StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
-        ArtMethod* m = stack_visitor->GetMethod();
-        // Ignore runtime frames (in particular callee save).
-        if (!m->IsRuntimeMethod()) {
-          stack_trace->push_back(m);
-        }
-        return true;
-      },
-      thread,
-      /* context= */ nullptr,
-      art::StackVisitor::StackWalkKind::kIncludeInlinedFrames);
-  Trace* the_trace = reinterpret_cast<Trace*>(arg);
-  the_trace->CompareAndUpdateStackTrace(thread, stack_trace);
-}
+// Checkpoint recording the stack of each thread at its next suspend point, so that sampling
+// does not need to suspend all threads. The samples are diffed and logged by the sampling
+// thread once all threads have passed the checkpoint.
+class SampleStackClosure final : public Closure {
+ public:
+  explicit SampleStackClosure(Barrier* barrier)
+      : lock_("Trace sample lock", kGenericBottomLock), barrier_(barrier) {}
+
+  ~SampleStackClosure() {
+    for (const Sample& sample : samples_) {
+      delete sample.stack_trace;
+    }
+  }
+
+  void Run(Thread* thread) override REQUIRES_SHARED(Locks::mutator_lock_) {
+    DCHECK(thread == Thread::Current() || thread->IsSuspended());
+    std::vector<ArtMethod*>* const stack_trace = new std::vector<ArtMethod*>();
+    StackVisitor::WalkStack(
+        [&](const art::StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+          ArtMethod* m = stack_visitor->GetMethod();
+          // Ignore runtime frames (in particular callee save).
+          if (!m->IsRuntimeMethod()) {
+            stack_trace->push_back(m);
+          }
+          return true;
+        },
+        thread,
+        /* context= */ nullptr,
+        art::StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+    {
+      MutexLock mu(Thread::Current(), lock_);
+      samples_.push_back({thread, thread->GetTid(), stack_trace});
+    }
+    barrier_->Pass(Thread::Current());
+  }
+
+  // Log the samples of threads that are still alive. Must be called after all threads have
+  // run the checkpoint.
+  void LogSamples(Trace* the_trace)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::thread_list_lock_) {
+    std::vector<Sample> samples;
+    {
+      MutexLock mu(Thread::Current(), lock_);
+      samples.swap(samples_);
+    }
+    ThreadList* thread_list = Runtime::Current()->GetThreadList();
+    for (const Sample& sample : samples) {
+      // The thread may have exited since it ran the checkpoint, and a new thread may have been
+      // allocated at the same address. Check the tid so that the sample is not attributed to it.
+      if (thread_list->Contains(sample.thread) && sample.thread->GetTid() == sample.tid) {
+        the_trace->CompareAndUpdateStackTrace(sample.thread, sample.stack_trace);
+      } else {
+        delete sample.stack_trace;
+      }
+    }
+  }
+
+ private:
+  struct Sample {
+    Thread* thread;
+    pid_t tid;
+    std::vector<ArtMethod*>* stack_trace;
+  };
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  std::vector<Sample> samples_ GUARDED_BY(lock_);
+  Barrier* const barrier_;
+};
 
 static void ClearThreadStackTraceAndClockBase(Thread* thread, void* arg ATTRIBUTE_UNUSED) {
   thread->SetTraceClockBase(0);
@@ -266,7 +307,7 @@ void Trace::CompareAndUpdateStackTrace(Thread* thread,
       LogMethodTraceEvent(thread, *rit, instrumentation::Instrumentation::kMethodEntered,
                           thread_clock_diff, wall_clock_diff);
     }
-    FreeStackTrace(old_stack_trace);
+    delete old_stack_trace;
   }
 }
 
@@ -290,15 +331,16 @@ void* Trace::RunSamplingThread(void* arg) {
       }
     }
     {
-      // Avoid a deadlock between a thread doing garbage collection
-      // and the profile sampling thread, by blocking GC when sampling
-      // thread stacks (see b/73624630).
-      gc::ScopedGCCriticalSection gcs(self,
-                                      art::gc::kGcCauseInstrumentation,
-                                      art::gc::kCollectorTypeInstrumentation);
-      ScopedSuspendAll ssa(__FUNCTION__);
+      ScopedObjectAccess soa(self);
+      Barrier barrier(0);
+      SampleStackClosure closure(&barrier);
+      size_t threads_running_checkpoint = runtime->GetThreadList()->RunCheckpoint(&closure);
+      if (threads_running_checkpoint != 0) {
+        ScopedThreadSuspension sts(self, kSuspended);
+        barrier.Increment(self, threads_running_checkpoint);
+      }
       MutexLock mu(self, *Locks::thread_list_lock_);
-      runtime->GetThreadList()->ForEach(GetSample, the_trace);
+      closure.LogSamples(the_trace);
     }
   }
 
@@ -484,6 +526,12 @@ void Trace::StopTracing(bool finish_tracing, bool flush_file) {
             instrumentation::Instrumentation::kMethodExited |
             instrumentation::Instrumentation::kMethodUnwind);
         runtime->GetInstrumentation()->DisableMethodTracing(kTracerInstrumentationKey);
+        // Write the events still buffered by each thread.
+        MutexLock mu(self, *Locks::thread_list_lock_);
+        runtime->GetThreadList()->ForEach([&](Thread* thread) {
+          Locks::mutator_lock_->AssertExclusiveHeld(self);
+          the_trace->FlushBuffer(thread);
+        });
       }
     }
     // At this point, code may read buf_ as it's writers are shutdown
@@ -883,34 +931,12 @@ void Trace::LogMethodTraceEvent(Thread* thread, ArtMethod* method,
   // This method is called in both tracing modes (method and
   // sampling). In sampling mode, this method is only called by the
   // sampling thread. In method tracing mode, it can be called
-  // concurrently.
+  // concurrently, and events are buffered by the calling thread.
 
   // Ensure we always use the non-obsolete version of the method so that entry/exit events have the
   // same pointer value.
   method = method->GetNonObsoleteMethod();
 
-  // Advance cur_offset_ atomically.
-  int32_t new_offset;
-  int32_t old_offset = 0;
-
-  // In the non-streaming case, we do a busy loop here trying to get
-  // an offset to write our record and advance cur_offset_ for the
-  // next use.
-  if (trace_output_mode_ != TraceOutputMode::kStreaming) {
-    // Although multiple threads can call this method concurrently,
-    // the compare_exchange_weak here is still atomic (by definition).
-    // A succeeding update is visible to other cores when they pass
-    // through this point.
-    old_offset = cur_offset_.load(std::memory_order_relaxed);  // Speculative read
-    do {
-      new_offset = old_offset + GetRecordSize(clock_source_);
-      if (static_cast<size_t>(new_offset) > buffer_size_) {
-        overflow_ = true;
-        return;
-      }
-    } while (!cur_offset_.compare_exchange_weak(old_offset, new_offset, std::memory_order_relaxed));
-  }
-
   TraceAction action = kTraceMethodEnter;
   switch (event) {
     case instrumentation::Instrumentation::kMethodEntered:
@@ -926,40 +952,112 @@ void Trace::LogMethodTraceEvent(Thread* thread, ArtMethod* method,
       UNIMPLEMENTED(FATAL) << "Unexpected event: " << event;
   }
 
-  uint32_t method_value = EncodeTraceMethodAndAction(method, action);
-
-  // Write data into the tracing buffer (if not streaming) or into a
-  // small buffer on the stack (if streaming) which we'll put into the
-  // tracing buffer below.
-  //
-  // These writes to the tracing buffer are synchronised with the
-  // future reads that (only) occur under FinishTracing(). The callers
-  // of FinishTracing() acquire locks and (implicitly) synchronise
-  // the buffer memory.
-  uint8_t* ptr;
-  static constexpr size_t kPacketSize = 14U;  // The maximum size of data in a packet.
-  uint8_t stack_buf[kPacketSize];             // Space to store a packet when in streaming mode.
-  if (trace_output_mode_ == TraceOutputMode::kStreaming) {
-    ptr = stack_buf;
+  ThreadTraceBuffer::Event trace_event = {method, action, thread_clock_diff, wall_clock_diff};
+  if (trace_mode_ == TraceMode::kSampling) {
+    WriteEvents(thread, &trace_event, 1u);
+    return;
+  }
+
+  DCHECK_EQ(thread, Thread::Current());
+  ThreadTraceBuffer* buffer = thread->GetMethodTraceBuffer();
+  if (buffer == nullptr) {
+    buffer = new ThreadTraceBuffer();
+    thread->SetMethodTraceBuffer(buffer);
+  } else if (buffer->num_events == ThreadTraceBuffer::kNumEvents) {
+    WriteEvents(thread, buffer->events, buffer->num_events);
+    buffer->num_events = 0;
+  }
+  buffer->events[buffer->num_events] = trace_event;
+  ++buffer->num_events;
+}
+
+void Trace::FlushBuffer(Thread* thread) {
+  ThreadTraceBuffer* buffer = thread->GetMethodTraceBuffer();
+  if (buffer != nullptr) {
+    WriteEvents(thread, buffer->events, buffer->num_events);
+    thread->SetMethodTraceBuffer(nullptr);
+    delete buffer;
+  }
+}
+
+void Trace::FlushThreadBuffer(Thread* thread) {
+  if (thread->GetMethodTraceBuffer() == nullptr) {
+    return;
+  }
+  MutexLock mu(Thread::Current(), *Locks::trace_lock_);
+  if (the_trace_ != nullptr) {
+    the_trace_->FlushBuffer(thread);
   } else {
-    ptr = buf_.get() + old_offset;
+    // Tracing is being stopped, drop the events.
+    delete thread->GetMethodTraceBuffer();
+    thread->SetMethodTraceBuffer(nullptr);
   }
+}
 
+void Trace::EncodeEvent(uint8_t* ptr, Thread* thread, const ThreadTraceBuffer::Event& event) {
   Append2LE(ptr, thread->GetTid());
-  Append4LE(ptr + 2, method_value);
+  Append4LE(ptr + 2, EncodeTraceMethodAndAction(event.method, event.action));
   ptr += 6;
 
   if (UseThreadCpuClock()) {
-    Append4LE(ptr, thread_clock_diff);
+    Append4LE(ptr, event.thread_clock_diff);
     ptr += 4;
   }
   if (UseWallClock()) {
-    Append4LE(ptr, wall_clock_diff);
+    Append4LE(ptr, event.wall_clock_diff);
   }
-  static_assert(kPacketSize == 2 + 4 + 4 + 4, "Packet size incorrect.");
+}
 
-  if (trace_output_mode_ == TraceOutputMode::kStreaming) {
-    MutexLock mu(Thread::Current(), *streaming_lock_);  // To serialize writing.
+void Trace::WriteEvents(Thread* thread,
+                        const ThreadTraceBuffer::Event* events,
+                        size_t num_events) {
+  const size_t record_size = GetRecordSize(clock_source_);
+  if (trace_output_mode_ != TraceOutputMode::kStreaming) {
+    // Reserve space for as many events as fit in the buffer with a
+    // single update of cur_offset_. Although multiple threads can
+    // reserve space concurrently, the compare_exchange_weak here is
+    // still atomic (by definition).
+    //
+    // These writes to the tracing buffer are synchronised with the
+    // future reads that (only) occur under FinishTracing(). The callers
+    // of FinishTracing() acquire locks and (implicitly) synchronise
+    // the buffer memory.
+    int32_t old_offset = cur_offset_.load(std::memory_order_relaxed);  // Speculative read
+    int32_t new_offset;
+    size_t num_written;
+    do {
+      size_t available = (buffer_size_ - static_cast<size_t>(old_offset)) / record_size;
+      num_written = std::min(num_events, available);
+      new_offset = old_offset + static_cast<int32_t>(num_written * record_size);
+    } while (!cur_offset_.compare_exchange_weak(old_offset, new_offset, std::memory_order_relaxed));
+    if (num_written != num_events) {
+      overflow_ = true;
+    }
+    uint8_t* ptr = buf_.get() + old_offset;
+    for (size_t i = 0; i != num_written; ++i) {
+      EncodeEvent(ptr, thread, events[i]);
+      ptr += record_size;
+    }
+    return;
+  }
+
+  static constexpr size_t kPacketSize = 14U;  // The maximum size of data in a packet.
+  static_assert(kPacketSize == 2 + 4 + 4 + 4, "Packet size incorrect.");
+  MutexLock mu(Thread::Current(), *streaming_lock_);  // To serialize writing.
+  if (RegisterThread(thread)) {
+    // It might be better to postpone this. Threads might not have received names...
+    std::string thread_name;
+    thread->GetThreadName(thread_name);
+    uint8_t buf2[7];
+    Append2LE(buf2, 0);
+    buf2[2] = kOpNewThread;
+    Append2LE(buf2 + 3, static_cast<uint16_t>(thread->GetTid()));
+    Append2LE(buf2 + 5, static_cast<uint16_t>(thread_name.length()));
+    WriteToBuf(buf2, sizeof(buf2));
+    WriteToBuf(reinterpret_cast<const uint8_t*>(thread_name.c_str()), thread_name.length());
+  }
+  for (size_t i = 0; i != num_events; ++i) {
+    ArtMethod* method = events[i].method;
     if (RegisterMethod(method)) {
       // Write a special block with the name.
       std::string method_line(GetMethodLine(method));
@@ -970,19 +1068,9 @@ void Trace::LogMethodTraceEvent(Thread* thread, ArtMethod* method,
       WriteToBuf(buf2, sizeof(buf2));
       WriteToBuf(reinterpret_cast<const uint8_t*>(method_line.c_str()), method_line.length());
     }
-    if (RegisterThread(thread)) {
-      // It might be better to postpone this. Threads might not have received names...
-      std::string thread_name;
-      thread->GetThreadName(thread_name);
-      uint8_t buf2[7];
-      Append2LE(buf2, 0);
-      buf2[2] = kOpNewThread;
-      Append2LE(buf2 + 3, static_cast<uint16_t>(thread->GetTid()));
-      Append2LE(buf2 + 5, static_cast<uint16_t>(thread_name.length()));
-      WriteToBuf(buf2, sizeof(buf2));
-      WriteToBuf(reinterpret_cast<const uint8_t*>(thread_name.c_str()), thread_name.length());
-    }
-    WriteToBuf(stack_buf, sizeof(stack_buf));
+    uint8_t packet[kPacketSize] = {};
+    EncodeEvent(packet, thread, events[i]);
+    WriteToBuf(packet, sizeof(packet));
   }
 }
 
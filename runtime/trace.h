@@ -101,6 +101,23 @@ enum TraceAction {
     kTraceMethodActionMask = 0x03,  // two bits
 };
 
+// Method trace events recorded by a thread in method tracing mode. Events are appended without
+// synchronization, and written to the trace when the buffer is full, when the thread exits or
+// when tracing stops.
+struct ThreadTraceBuffer {
+  static constexpr size_t kNumEvents = 256;
+
+  struct Event {
+    ArtMethod* method;
+    TraceAction action;
+    uint32_t thread_clock_diff;
+    uint32_t wall_clock_diff;
+  };
+
+  size_t num_events = 0;
+  Event events[kNumEvents];
+};
+
 // Class for recording event traces. Trace data is either collected
 // synchronously during execution (TracingMode::kMethodTracingActive),
 // or by a separate sampling thread (TracingMode::kSampleProfilingActive).
@@ -226,12 +243,11 @@ class Trace final : public instrumentation::InstrumentationListener {
       REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!unique_methods_lock_) override;
   void WatchedFramePop(Thread* thread, const ShadowFrame& frame)
       REQUIRES_SHARED(Locks::mutator_lock_) override;
-  // Reuse an old stack trace if it exists, otherwise allocate a new one.
-  static std::vector<ArtMethod*>* AllocStackTrace();
-  // Clear and store an old stack trace for later use.
-  static void FreeStackTrace(std::vector<ArtMethod*>* stack_trace);
   // Save id and name of a thread before it exits.
   static void StoreExitingThreadInfo(Thread* thread);
+  // Write the buffered method trace events of an exiting thread.
+  static void FlushThreadBuffer(Thread* thread)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!Locks::trace_lock_);
 
   static TraceOutputMode GetOutputMode() REQUIRES(!Locks::trace_lock_);
   static TraceMode GetMode() REQUIRES(!Locks::trace_lock_);
@@ -267,6 +283,14 @@ class Trace final : public instrumentation::InstrumentationListener {
                            uint32_t thread_clock_diff, uint32_t wall_clock_diff)
       REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!unique_methods_lock_, !streaming_lock_);
 
+  // Write the events buffered by `thread` to the trace and release its buffer.
+  void FlushBuffer(Thread* thread)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!unique_methods_lock_, !streaming_lock_);
+  void WriteEvents(Thread* thread, const ThreadTraceBuffer::Event* events, size_t num_events)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!unique_methods_lock_, !streaming_lock_);
+  void EncodeEvent(uint8_t* ptr, Thread* thread, const ThreadTraceBuffer::Event& event)
+      REQUIRES(!unique_methods_lock_);
+
   // Methods to output traced methods and threads.
   void GetVisitedMethods(size_t end_offset, std::set<ArtMethod*>* visited_methods)
       REQUIRES(!unique_methods_lock_);
@@ -308,9 +332,6 @@ class Trace final : public instrumentation::InstrumentationListener {
   // Sampling thread, non-zero when sampling.
   static pthread_t sampling_pthread_;
 
-  // Used to remember an unused stack trace to avoid re-allocation during sampling.
-  static std::unique_ptr<std::vector<ArtMethod*>> temp_stack_trace_;
-
   // File to write trace data out to, null if direct to ddms.
   std::unique_ptr<File> trace_file_;
 
@@ -353,8 +374,9 @@ class Trace final : public instrumentation::InstrumentationListener {
   // so cur_offset_ can move forwards and backwards.
   //
   // When not in streaming mode, the buf_ writes can come from
-  // multiple threads when the trace mode is kMethodTracing. When
-  // trace mode is kSampling, writes only come from the sampling
+  // multiple threads when the trace mode is kMethodTracing, each
+  // thread reserving space for a whole ThreadTraceBuffer at once.
+  // When trace mode is kSampling, writes only come from the sampling
   // thread.
   //
   // Reads to the buffer happen after the event sources writing to the
@@ -50,6 +50,10 @@ public class Main {
   /// CHECK-START: int Main.set32(java.lang.Object, long, int) builder (after)
   /// CHECK-DAG: <<Result:i\d+>> InvokeVirtual intrinsic:UnsafeGetAndSetInt
   /// CHECK-DAG:                 Return [<<Result>>]
+  //
+  /// CHECK-START-X86_64: int Main.set32(java.lang.Object, long, int) disassembly (after)
+  /// CHECK:                     InvokeVirtual intrinsic:UnsafeGetAndSetInt
+  /// CHECK-NEXT:                xchg [{{r\w+}} + {{[^\]]+}}], eax
   private static int set32(Object o, long offset, int newValue) {
     return unsafe.getAndSetInt(o, offset, newValue);
   }
@@ -57,6 +61,10 @@ public class Main {
   /// CHECK-START: long Main.set64(java.lang.Object, long, long) builder (after)
   /// CHECK-DAG: <<Result:j\d+>> InvokeVirtual intrinsic:UnsafeGetAndSetLong
   /// CHECK-DAG:                 Return [<<Result>>]
+  //
+  /// CHECK-START-X86_64: long Main.set64(java.lang.Object, long, long) disassembly (after)
+  /// CHECK:                     InvokeVirtual intrinsic:UnsafeGetAndSetLong
+  /// CHECK-NEXT:                xchg [{{r\w+}} + {{[^\]]+}}], rax
   private static long set64(Object o, long offset, long newValue) {
     return unsafe.getAndSetLong(o, offset, newValue);
   }
@@ -64,6 +72,20 @@ public class Main {
   /// CHECK-START: java.lang.Object Main.setObj(java.lang.Object, long, java.lang.Object) builder (after)
   /// CHECK-DAG: <<Result:l\d+>> InvokeVirtual intrinsic:UnsafeGetAndSetObject
   /// CHECK-DAG:                 Return [<<Result>>]
+  //
+  // The old reference is marked before the exchange, and the card of the holder is dirtied.
+  /// CHECK-START-X86_64: java.lang.Object Main.setObj(java.lang.Object, long, java.lang.Object) disassembly (after)
+  /// CHECK:                     InvokeVirtual intrinsic:UnsafeGetAndSetObject
+  /// CHECK-IF: os.environ.get('ART_USE_READ_BARRIER') != 'false'
+  ///   CHECK-NEXT:              test [{{r\w+}} + 7], 16
+  ///   CHECK-NEXT:              mov {{\w+}}, [{{r\w+}} + {{[^\]]+}}]
+  ///   CHECK-NEXT:              jnz/ne
+  /// CHECK-FI:
+  /// CHECK:                     card_table
+  /// CHECK:                     shr {{r\w+}}, 10
+  /// CHECK:                     xchg [{{r\w+}} + {{[^\]]+}}], {{\w+}}
+  /// CHECK-NOT:                 call
+  /// CHECK:                     Return
   private static Object setObj(Object o, long offset, Object newValue) {
     return unsafe.getAndSetObject(o, offset, newValue);
   }
@@ -75,6 +97,10 @@ public class Main {
   /// CHECK-START: int Main.add32(java.lang.Object, long, int) builder (after)
   /// CHECK-DAG: <<Result:i\d+>> InvokeVirtual intrinsic:UnsafeGetAndAddInt
   /// CHECK-DAG:                 Return [<<Result>>]
+  //
+  /// CHECK-START-X86_64: int Main.add32(java.lang.Object, long, int) disassembly (after)
+  /// CHECK:                     InvokeVirtual intrinsic:UnsafeGetAndAddInt
+  /// CHECK-NEXT:                lock xadd [{{r\w+}} + {{[^\]]+}}], eax
   private static int add32(Object o, long offset, int delta) {
     return unsafe.getAndAddInt(o, offset, delta);
   }
@@ -82,6 +108,10 @@ public class Main {
   /// CHECK-START: long Main.add64(java.lang.Object, long, long) builder (after)
   /// CHECK-DAG: <<Result:j\d+>> InvokeVirtual intrinsic:UnsafeGetAndAddLong
   /// CHECK-DAG:                 Return [<<Result>>]
+  //
+  /// CHECK-START-X86_64: long Main.add64(java.lang.Object, long, long) disassembly (after)
+  /// CHECK:                     InvokeVirtual intrinsic:UnsafeGetAndAddLong
+  /// CHECK-NEXT:                lock xadd [{{r\w+}} + {{[^\]]+}}], rax
   private static long add64(Object o, long offset, long delta) {
     return unsafe.getAndAddLong(o, offset, delta);
   }
@@ -169,21 +199,43 @@ public class Main {
 
     // Some checks on setters and adders within same thread.
 
-    set32(m, intOffset, 3);
+    expectEqual32(0, set32(m, intOffset, 3));
     expectEqual32(3, m.i);
 
-    set64(m, longOffset, 7L);
+    expectEqual64(0L, set64(m, longOffset, 7L));
     expectEqual64(7L, m.l);
 
-    setObj(m, objOffset, m);
+    expectEqualObj(null, setObj(m, objOffset, m));
     expectEqualObj(m, m.o);
 
-    add32(m, intOffset, 11);
+    expectEqual32(3, add32(m, intOffset, 11));
     expectEqual32(14, m.i);
 
-    add64(m, longOffset, 13L);
+    expectEqual64(7L, add64(m, longOffset, 13L));
     expectEqual64(20L, m.l);
 
+    // The adders wrap around, and return the value before the addition.
+
+    expectEqual32(14, add32(m, intOffset, Integer.MAX_VALUE));
+    expectEqual32(Integer.MIN_VALUE + 13, m.i);
+    expectEqual32(Integer.MIN_VALUE + 13, add32(m, intOffset, -13));
+    expectEqual32(Integer.MIN_VALUE, m.i);
+
+    expectEqual64(20L, add64(m, longOffset, Long.MAX_VALUE));
+    expectEqual64(Long.MIN_VALUE + 19L, m.l);
+    expectEqual64(Long.MIN_VALUE + 19L, add64(m, longOffset, -19L));
+    expectEqual64(Long.MIN_VALUE, m.l);
+
+    // A reference stored with setObj() must survive a collection, which relies on the card
+    // marking of the holder.
+
+    Object fresh = new Object[] { "fresh" };
+    expectEqualObj(m, setObj(m, objOffset, fresh));
+    Runtime.getRuntime().gc();
+    expectEqualObj(fresh, setObj(m, objOffset, m));
+    expectEqualObj("fresh", ((Object[]) fresh)[0]);
+    expectEqualObj(m, m.o);
+
     // Some checks on setters within different threads.
 
     fork(new Runnable() {
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START: int Main.$noinline$unbox(int) instruction_simplifier$after_inlining (before)
+  /// CHECK-DAG: <<Arg:i\d+>>     ParameterValue
+  /// CHECK-DAG: <<Box:l\d+>>     InvokeStaticOrDirect [<<Arg>>{{(,[ij]\d+)?}}] intrinsic:IntegerValueOf
+  /// CHECK-DAG: <<Get:i\d+>>     InstanceFieldGet field_name:java.lang.Integer.value
+  /// CHECK-DAG:                  Return [<<Get>>]
+
+  /// CHECK-START: int Main.$noinline$unbox(int) instruction_simplifier$after_inlining (after)
+  /// CHECK-DAG: <<Arg:i\d+>>     ParameterValue
+  /// CHECK-DAG:                  Return [<<Arg>>]
+
+  /// CHECK-START: int Main.$noinline$unbox(int) instruction_simplifier$after_inlining (after)
+  /// CHECK-NOT:                  InstanceFieldGet
+  public static int $noinline$unbox(int value) {
+    Integer box = Integer.valueOf(value);
+    return box.intValue();
+  }
+
+  /// CHECK-START: int Main.$noinline$sumOfBoxes(int) instruction_simplifier$after_inlining (after)
+  /// CHECK-NOT:                  InstanceFieldGet
+  public static int $noinline$sumOfBoxes(int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+      Integer box = i;
+      sum += box;
+    }
+    return sum;
+  }
+
+  /// CHECK-START: java.lang.Integer Main.$noinline$boxEscapes(int) instruction_simplifier$after_inlining (after)
+  /// CHECK-DAG: <<Arg:i\d+>>     ParameterValue
+  /// CHECK-DAG: <<Box:l\d+>>     InvokeStaticOrDirect [<<Arg>>{{(,[ij]\d+)?}}] intrinsic:IntegerValueOf
+  /// CHECK-DAG:                  Return [<<Box>>]
+  public static Integer $noinline$boxEscapes(int value) {
+    Integer box = Integer.valueOf(value);
+    sideEffect = box.intValue();
+    return box;
+  }
+
+  public static void main(String[] args) {
+    assertEquals(42, $noinline$unbox(42));
+    assertEquals(55555, $noinline$unbox(55555));
+    assertEquals(-129, $noinline$unbox(-129));
+    assertEquals(4950, $noinline$sumOfBoxes(100));
+    assertEquals(1234, $noinline$boxEscapes(1234).intValue());
+    assertEquals(1234, sideEffect);
+    System.out.println("passed");
+  }
+
+  private static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+
+  static int sideEffect;
+}
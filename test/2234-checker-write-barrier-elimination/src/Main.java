@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  Object field1;
+  Object field2;
+  Object field3;
+
+  /// CHECK-START: Main Main.$noinline$freshObject(java.lang.Object, java.lang.Object) write_barrier_elimination (before)
+  /// CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:EmitWithNullCheck
+  /// CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:EmitWithNullCheck
+
+  /// CHECK-START: Main Main.$noinline$freshObject(java.lang.Object, java.lang.Object) write_barrier_elimination (after)
+  /// CHECK-IF: os.environ.get('ART_USE_READ_BARRIER') != 'false'
+  ///     CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:DontEmit
+  ///     CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:DontEmit
+  /// CHECK-ELSE:
+  ///     CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:DontEmit
+  ///     CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:EmitNoNullCheck
+  /// CHECK-FI:
+  public static Main $noinline$freshObject(Object a, Object b) {
+    Main m = new Main();
+    m.field1 = a;
+    m.field2 = b;
+    return m;
+  }
+
+  /// CHECK-START: void Main.$noinline$coalesce(Main, java.lang.Object, java.lang.Object) write_barrier_elimination (after)
+  /// CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:DontEmit
+  /// CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:DontEmit
+  /// CHECK: InstanceFieldSet field_name:Main.field3 write_barrier_kind:EmitNoNullCheck
+  public static void $noinline$coalesce(Main m, Object a, Object b) {
+    m.field1 = a;
+    m.field2 = b;
+    m.field3 = a;
+  }
+
+  /// CHECK-START: void Main.$noinline$nullStoreDoesNotCover(Main, java.lang.Object) write_barrier_elimination (after)
+  /// CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:EmitWithNullCheck
+  /// CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:EmitWithNullCheck
+  public static void $noinline$nullStoreDoesNotCover(Main m, Object a) {
+    m.field1 = a;
+    m.field2 = null;
+  }
+
+  /// CHECK-START: void Main.$noinline$callBetweenStores(Main, java.lang.Object, java.lang.Object) write_barrier_elimination (after)
+  /// CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:EmitWithNullCheck
+  /// CHECK: InvokeStaticOrDirect
+  /// CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:EmitWithNullCheck
+  public static void $noinline$callBetweenStores(Main m, Object a, Object b) {
+    m.field1 = a;
+    $noinline$emptyMethod();
+    m.field2 = b;
+  }
+
+  /// CHECK-START: void Main.$noinline$allocationBetweenStores(Main, java.lang.Object) write_barrier_elimination (after)
+  /// CHECK: InstanceFieldSet field_name:Main.field1 write_barrier_kind:EmitWithNullCheck
+  /// CHECK: NewInstance
+  /// CHECK: InstanceFieldSet field_name:Main.field2 write_barrier_kind:EmitWithNullCheck
+  public static void $noinline$allocationBetweenStores(Main m, Object a) {
+    m.field1 = a;
+    m.field2 = new Object();
+  }
+
+  public static void $noinline$emptyMethod() {}
+
+  public static void main(String[] args) {
+    Object a = new Object();
+    Object b = new Object();
+
+    Main m = $noinline$freshObject(a, b);
+    assertSame(a, m.field1);
+    assertSame(b, m.field2);
+
+    $noinline$coalesce(m, b, a);
+    assertSame(b, m.field1);
+    assertSame(a, m.field2);
+    assertSame(b, m.field3);
+
+    $noinline$nullStoreDoesNotCover(m, a);
+    assertSame(a, m.field1);
+    assertSame(null, m.field2);
+
+    $noinline$callBetweenStores(m, b, a);
+    assertSame(b, m.field1);
+    assertSame(a, m.field2);
+
+    $noinline$allocationBetweenStores(m, a);
+    assertSame(a, m.field1);
+    if (m.field2 == null || m.field2 == a || m.field2 == b) {
+      throw new Error("Unexpected value in field2");
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void assertSame(Object expected, Object actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected + ", got " + actual);
+    }
+  }
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for 256-bit vectorization on AVX2-enabled x86-64.
+ */
+public class Main {
+
+  /// CHECK-START-X86_64: void Main.addInts(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Incr:i\d+>>  IntConstant 8                               loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                         loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Get1:d\d+>>  VecLoad [{{l\d+}},<<Phi>>]                  loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Get2:d\d+>>  VecLoad [{{l\d+}},<<Phi>>]                  loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Add:d\d+>>   VecAdd [<<Get1>>,<<Get2>>] packed_type:Int32 loop:<<Loop>>     outer_loop:none
+  ///     CHECK-DAG:                VecStore [{{l\d+}},<<Phi>>,<<Add>>]         loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Incr>>]                      loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-DAG: <<Incr:i\d+>>  IntConstant 4                               loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                         loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Incr>>]                      loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void addInts(int[] a, int[] b, int[] c) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = b[i] + c[i];
+    }
+  }
+
+  /// CHECK-START-X86_64: void Main.mulBytes(byte[], byte[], byte[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Incr:i\d+>>  IntConstant 32                              loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                         loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Get1:d\d+>>  VecLoad [{{l\d+}},<<Phi>>]                  loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Get2:d\d+>>  VecLoad [{{l\d+}},<<Phi>>]                  loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Mul:d\d+>>   VecMul [<<Get1>>,<<Get2>>] packed_type:Int8 loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                VecStore [{{l\d+}},<<Phi>>,<<Mul>>]         loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Incr>>]                      loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-ELSE:
+  //
+  ///     CHECK-NOT:                VecMul
+  //
+  /// CHECK-FI:
+  private static void mulBytes(byte[] a, byte[] b, byte[] c) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = (byte) (b[i] * c[i]);
+    }
+  }
+
+  /// CHECK-START-X86_64: void Main.absShorts(short[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                         loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG: <<Get:d\d+>>   VecLoad [{{l\d+}},<<Phi>>]                  loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG: <<Abs:d\d+>>   VecAbs [<<Get>>] packed_type:Int16          loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                VecStore [{{l\d+}},<<Phi>>,<<Abs>>]         loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static void absShorts(short[] a) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = (short) Math.abs(a[i]);
+    }
+  }
+
+  /// CHECK-START-X86_64: float Main.sumScaled(float[], float[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Incr:i\d+>>  IntConstant 8                               loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                         loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG:                VecMul packed_type:Float32                  loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Incr>>]                      loop:<<Loop>>      outer_loop:none
+  //
+  /// CHECK-FI:
+  private static float sumScaled(float[] a, float[] b) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = b[i] * 2.5f;
+    }
+    return a[a.length - 1];
+  }
+
+  /// CHECK-START-X86_64: long Main.sumLongs(long[]) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG: <<Incr:i\d+>>  IntConstant 4                               loop:none
+  ///     CHECK-DAG: <<Phi:i\d+>>   Phi                                         loop:<<Loop:B\d+>> outer_loop:none
+  ///     CHECK-DAG:                Add [<<Phi>>,<<Incr>>]                      loop:<<Loop>>      outer_loop:none
+  ///     CHECK-DAG:                VecReduce                                   loop:none
+  //
+  /// CHECK-FI:
+  private static long sumLongs(long[] a) {
+    long sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      sum += a[i];
+    }
+    return sum;
+  }
+
+  interface Scaler {
+    float $noinline$scale(float x);
+  }
+
+  static class HalfScaler implements Scaler {
+    public float $noinline$scale(float x) {
+      return x * 0.5f;
+    }
+  }
+
+  static class DoubleScaler implements Scaler {
+    public float $noinline$scale(float x) {
+      return x * 2.0f;
+    }
+  }
+
+  // Interface calls out of ymm code must clear the upper ymm state like other calls.
+  /// CHECK-START-X86_64: float Main.scaleThenCall(float[], Main$Scaler) loop_optimization (after)
+  /// CHECK-IF:     hasIsaFeature("avx2")
+  //
+  ///     CHECK-DAG:                VecMul packed_type:Float32                  loop:{{B\d+}}      outer_loop:none
+  ///     CHECK-DAG:                InvokeInterface                             loop:none
+  //
+  /// CHECK-FI:
+  private static float scaleThenCall(float[] a, Scaler scaler) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = a[i] * 2.0f;
+    }
+    return scaler.$noinline$scale(a.length > 0 ? a[0] : 1.0f);
+  }
+
+  private static int sumInts(int[] a) {
+    int sum = 0;
+    for (int i = 0; i < a.length; i++) {
+      sum += a[i];
+    }
+    return sum;
+  }
+
+  private static String decode(String s, char[] out) {
+    for (int i = 0; i < s.length(); i++) {
+      out[i] = s.charAt(i);
+    }
+    return new String(out);
+  }
+
+  public static void main(String[] args) {
+    // Use lengths that exercise both the vector loop and the scalar cleanup loop.
+    for (int n = 0; n <= 100; n += 7) {
+      int[] ia = new int[n];
+      int[] ib = new int[n];
+      int[] ic = new int[n];
+      byte[] ba = new byte[n];
+      byte[] bb = new byte[n];
+      byte[] bc = new byte[n];
+      short[] sa = new short[n];
+      float[] fa = new float[n];
+      float[] fb = new float[n];
+      long[] la = new long[n];
+      long expectedLongSum = 0;
+      for (int i = 0; i < n; i++) {
+        ib[i] = i * 1000003;
+        ic[i] = -i * 7;
+        bb[i] = (byte) (i * 31);
+        bc[i] = (byte) (-i * 13 + 5);
+        sa[i] = (short) ((i & 1) == 0 ? -i * 301 : i * 157);
+        fb[i] = i * 0.5f;
+        la[i] = (long) i * 0x100000001L;
+        expectedLongSum += la[i];
+      }
+      addInts(ia, ib, ic);
+      mulBytes(ba, bb, bc);
+      absShorts(sa);
+      if (n > 0) {
+        expectEquals(fb[n - 1] * 2.5f, sumScaled(fa, fb));
+      }
+      for (int i = 0; i < n; i++) {
+        expectEquals(i * 1000003 - i * 7, ia[i]);
+        expectEquals((byte) ((byte) (i * 31) * (byte) (-i * 13 + 5)), ba[i]);
+        expectEquals((short) Math.abs((short) ((i & 1) == 0 ? -i * 301 : i * 157)), sa[i]);
+        expectEquals(i * 0.5f * 2.5f, fa[i]);
+      }
+      expectEquals(expectedLongSum, sumLongs(la));
+      int expectedIntSum = 0;
+      for (int i = 0; i < n; i++) {
+        expectedIntSum += ib[i];
+      }
+      expectEquals(expectedIntSum, sumInts(ib));
+      float[] fc = new float[n];
+      for (int i = 0; i < n; i++) {
+        fc[i] = i + 1.0f;
+      }
+      expectEquals(n > 0 ? 1.0f : 0.5f, scaleThenCall(fc, new HalfScaler()));
+      expectEquals(n > 0 ? 8.0f : 2.0f, scaleThenCall(fc, new DoubleScaler()));
+      for (int i = 0; i < n; i++) {
+        expectEquals((i + 1.0f) * 4.0f, fc[i]);
+      }
+    }
+    String s = "compressed and uncompressed ሴ strings";
+    expectEquals(s, decode(s, new char[s.length()]));
+    expectEquals("latin1 only string", decode("latin1 only string", new char[18]));
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(float expected, float result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(String expected, String result) {
+    if (!expected.equals(result)) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
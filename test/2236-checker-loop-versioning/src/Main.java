@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for loop unswitching and loop versioning (run with --loop-versioning).
+ */
+public class Main {
+
+  // Bounds check elimination leaves the checks to loop versioning instead of deoptimizing.
+  //
+  /// CHECK-START: void Main.remInto(int[], int[], int) BCE (after)
+  /// CHECK-NOT: Deoptimize
+  //
+  /// CHECK-START: void Main.remInto(int[], int[], int) loop_optimization (before)
+  /// CHECK-DAG: NullCheck   loop:<<Loop:B\d+>>
+  /// CHECK-DAG: BoundsCheck loop:<<Loop>>
+  //
+  // The null and range tests are done before the loop.
+  //
+  /// CHECK-START: void Main.remInto(int[], int[], int) loop_optimization (after)
+  /// CHECK-DAG: <<Null:l\d+>> NullConstant                 loop:none
+  /// CHECK-DAG:               NotEqual [{{l\d+}},<<Null>>] loop:none
+  /// CHECK-DAG:               Below                        loop:none
+  //
+  // The original loop, whose blocks come first, has no checks left. The checks are all in the
+  // copy. The remainder keeps both loops from being vectorized.
+  //
+  /// CHECK-START: void Main.remInto(int[], int[], int) loop_optimization (after)
+  /// CHECK-NOT: NullCheck
+  /// CHECK-NOT: BoundsCheck
+  /// CHECK:     ArraySet    loop:<<Fast:B\d+>>
+  /// CHECK:     NullCheck   loop:<<Slow:B\d+>>
+  /// CHECK:     BoundsCheck loop:<<Slow>>
+  /// CHECK:     ArraySet    loop:<<Slow>>
+  /// CHECK-EVAL: "<<Fast>>" != "<<Slow>>"
+  private static void remInto(int[] a, int[] b, int n) {
+    for (int i = 0; i < n; i++) {
+      a[i] += b[i] % 7;
+    }
+  }
+
+  /// CHECK-START: void Main.fill(int[], boolean) loop_optimization (before)
+  /// CHECK-DAG: <<Up:z\d+>> ParameterValue
+  /// CHECK-DAG:             If [<<Up>>] loop:{{B\d+}}
+  //
+  // The loop is unswitched on `up`: the original loop takes the true branch and the copy
+  // takes the false one.
+  //
+  /// CHECK-START: void Main.fill(int[], boolean) loop_optimization (after)
+  /// CHECK-DAG: <<Up:z\d+>>    ParameterValue
+  /// CHECK-DAG: <<Const0:i\d+>> IntConstant 0
+  /// CHECK-DAG: <<Const1:i\d+>> IntConstant 1
+  /// CHECK-DAG:                 If [<<Up>>]     loop:none
+  /// CHECK-DAG:                 If [<<Const1>>] loop:<<TrueLoop:B\d+>>
+  /// CHECK-DAG:                 If [<<Const0>>] loop:<<FalseLoop:B\d+>>
+  /// CHECK-EVAL: "<<TrueLoop>>" != "<<FalseLoop>>"
+  //
+  /// CHECK-START: void Main.fill(int[], boolean) dead_code_elimination$final (after)
+  /// CHECK-DAG: ArraySet loop:<<Loop1:B\d+>>
+  /// CHECK-DAG: ArraySet loop:<<Loop2:B\d+>>
+  /// CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  //
+  /// CHECK-START: void Main.fill(int[], boolean) dead_code_elimination$final (after)
+  /// CHECK:     <<Up:z\d+>> ParameterValue
+  /// CHECK-NOT:             If [<<Up>>] loop:{{B\d+}}
+  private static void fill(int[] a, boolean up) {
+    for (int i = 0; i < a.length; i++) {
+      if (up) {
+        a[i] = i;
+      } else {
+        a[i] = -i;
+      }
+    }
+  }
+
+  public static void main(String[] args) {
+    int[] a = new int[100];
+    int[] b = new int[100];
+    fill(a, true);
+    fill(b, false);
+    for (int i = 0; i < 100; i++) {
+      expectEquals(i, a[i]);
+      expectEquals(-i, b[i]);
+    }
+
+    // Versioned loop without checks.
+    fill(b, true);
+    remInto(a, b, 100);
+    for (int i = 0; i < 100; i++) {
+      expectEquals(i + i % 7, a[i]);
+    }
+
+    // Fully checked loop: the range test fails.
+    try {
+      remInto(a, b, 101);
+      throw new Error("Expected ArrayIndexOutOfBoundsException");
+    } catch (ArrayIndexOutOfBoundsException expected) {
+    }
+    for (int i = 0; i < 100; i++) {
+      expectEquals(i + 2 * (i % 7), a[i]);
+    }
+
+    // Fully checked loop: the null test fails.
+    try {
+      remInto(a, null, 10);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+    }
+    remInto(null, null, 0);
+    remInto(a, b, -1);
+    for (int i = 0; i < 100; i++) {
+      expectEquals(i + 2 * (i % 7), a[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
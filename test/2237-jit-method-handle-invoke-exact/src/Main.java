@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+import java.lang.invoke.WrongMethodTypeException;
+
+public class Main {
+  static final MethodHandle STATIC_ADD;
+  static final MethodHandle VIRTUAL_ADD;
+  static final MethodHandle PRIVATE_ADD;
+  // A handle with a nominal type, `(int, int)long`, different from its type, `(int, int)int`.
+  static final MethodHandle AS_TYPE_ADD;
+
+  static {
+    try {
+      MethodHandles.Lookup lookup = MethodHandles.lookup();
+      MethodType type = MethodType.methodType(int.class, int.class, int.class);
+      STATIC_ADD = lookup.findStatic(Main.class, "staticAdd", type);
+      VIRTUAL_ADD = lookup.findVirtual(Main.class, "virtualAdd", type);
+      PRIVATE_ADD = lookup.findSpecial(Main.class, "privateAdd", type, Main.class);
+      AS_TYPE_ADD = STATIC_ADD.asType(MethodType.methodType(long.class, int.class, int.class));
+    } catch (ReflectiveOperationException e) {
+      throw new Error(e);
+    }
+  }
+
+  final int bias;
+
+  Main(int bias) {
+    this.bias = bias;
+  }
+
+  static int staticAdd(int a, int b) {
+    return a + b;
+  }
+
+  int virtualAdd(int a, int b) {
+    return a + b + bias;
+  }
+
+  private int privateAdd(int a, int b) {
+    return a + b - bias;
+  }
+
+  static class Sub extends Main {
+    Sub() {
+      super(0);
+    }
+
+    @Override
+    int virtualAdd(int a, int b) {
+      return a * b;
+    }
+  }
+
+  static int callStatic(int a, int b) throws Throwable {
+    return (int) STATIC_ADD.invokeExact(a, b);
+  }
+
+  static int callVirtual(Main m, int a, int b) throws Throwable {
+    return (int) VIRTUAL_ADD.invokeExact(m, a, b);
+  }
+
+  static int callPrivate(Main m, int a, int b) throws Throwable {
+    return (int) PRIVATE_ADD.invokeExact(m, a, b);
+  }
+
+  static long callWithWrongType(int a, int b) throws Throwable {
+    return (long) STATIC_ADD.invokeExact(a, b);
+  }
+
+  static long callAsTypeWithNominalType(int a, int b) throws Throwable {
+    return (long) AS_TYPE_ADD.invokeExact(a, b);
+  }
+
+  // Matches the type of the target method but not the nominal type of the handle.
+  static int callAsTypeWithHandleType(int a, int b) throws Throwable {
+    return (int) AS_TYPE_ADD.invokeExact(a, b);
+  }
+
+  public static void main(String[] args) throws Throwable {
+    // The JIT is only forced when the test library is passed in, i.e. not when run as a
+    // standalone test, which still checks the results.
+    boolean forceJit = args.length > 0;
+    if (forceJit) {
+      System.loadLibrary(args[0]);
+    }
+    Main main = new Main(10);
+    Main sub = new Sub();
+    // Loop enough to get the callers hot before asking for them to be compiled.
+    for (int i = 0; i < 10000; i++) {
+      callStatic(i, 1);
+      callVirtual(main, i, 1);
+      callVirtual(sub, i, 1);
+      callPrivate(main, i, 1);
+      callAsTypeWithNominalType(i, 1);
+      try {
+        callAsTypeWithHandleType(i, 1);
+        throw new Error("Expected WrongMethodTypeException");
+      } catch (WrongMethodTypeException expected) {
+      }
+    }
+    if (forceJit) {
+      ensureJitCompiled(Main.class, "callStatic");
+      ensureJitCompiled(Main.class, "callVirtual");
+      ensureJitCompiled(Main.class, "callPrivate");
+      ensureJitCompiled(Main.class, "callWithWrongType");
+      ensureJitCompiled(Main.class, "callAsTypeWithNominalType");
+      ensureJitCompiled(Main.class, "callAsTypeWithHandleType");
+    }
+
+    expectEquals(5, callStatic(2, 3));
+    expectEquals(15, callVirtual(main, 2, 3));
+    expectEquals(6, callVirtual(sub, 2, 3));
+    expectEquals(-5, callPrivate(main, 2, 3));
+    expectEquals(5, callPrivate(sub, 2, 3));
+    expectEquals(5L, callAsTypeWithNominalType(2, 3));
+
+    try {
+      callVirtual(null, 2, 3);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+    }
+    try {
+      callPrivate(null, 2, 3);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+    }
+    try {
+      callWithWrongType(2, 3);
+      throw new Error("Expected WrongMethodTypeException");
+    } catch (WrongMethodTypeException expected) {
+    }
+    try {
+      callAsTypeWithHandleType(2, 3);
+      throw new Error("Expected WrongMethodTypeException");
+    } catch (WrongMethodTypeException expected) {
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+
+public class Main {
+  public static void main(String[] args) throws Exception {
+    Class<?> c = Class.forName("ConstMethodHandles");
+    c.getMethod("resolveTargets").invoke(null);
+
+    Method staticBootTarget = c.getMethod("staticBootTarget", int.class);
+    expectEquals(5, staticBootTarget.invoke(null, -5));
+    expectEquals(7, staticBootTarget.invoke(null, 7));
+
+    Method instanceBootTarget = c.getMethod("instanceBootTarget", String.class);
+    expectEquals(6, instanceBootTarget.invoke(null, "passed"));
+    try {
+      instanceBootTarget.invoke(null, (Object) null);
+      throw new Error("Expected NullPointerException");
+    } catch (InvocationTargetException e) {
+      if (!(e.getCause() instanceof NullPointerException)) {
+        throw new Error("Expected NullPointerException", e.getCause());
+      }
+    }
+
+    Method staticAppTarget = c.getMethod("staticAppTarget", int.class, int.class);
+    expectEquals(5, staticAppTarget.invoke(null, 2, 3));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, Object result) {
+    if (expected != (Integer) result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
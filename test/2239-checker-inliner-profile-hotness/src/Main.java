@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  // Over the default limit of 32 code units, but within twice that.
+  static int hotCallee(int a) {
+    a = a * 31 + 1;
+    a = a * 31 + 2;
+    a = a * 31 + 3;
+    a = a * 31 + 4;
+    a = a * 31 + 5;
+    a = a * 31 + 6;
+    a = a * 31 + 7;
+    a = a * 31 + 8;
+    a = a * 31 + 9;
+    return a;
+  }
+
+  // Within the default limit of 32 code units, but over a quarter of it.
+  static int startupOnlyCallee(int a) {
+    a = a * 31 + 1;
+    a = a * 31 + 2;
+    a = a * 31 + 3;
+    return a;
+  }
+
+  // Same as above, but missing from the profile.
+  static int unprofiledCallee(int a) {
+    a = a * 31 + 1;
+    a = a * 31 + 2;
+    a = a * 31 + 3;
+    return a;
+  }
+
+  /// CHECK-START: int Main.callHot(int) inliner (before)
+  /// CHECK:       InvokeStaticOrDirect method_name:Main.hotCallee
+
+  /// CHECK-START: int Main.callHot(int) inliner (after)
+  /// CHECK-NOT:   InvokeStaticOrDirect method_name:Main.hotCallee
+  public static int callHot(int a) {
+    return hotCallee(a);
+  }
+
+  /// CHECK-START: int Main.callStartupOnly(int) inliner (after)
+  /// CHECK:       InvokeStaticOrDirect method_name:Main.startupOnlyCallee
+  public static int callStartupOnly(int a) {
+    return startupOnlyCallee(a);
+  }
+
+  /// CHECK-START: int Main.callUnprofiled(int) inliner (before)
+  /// CHECK:       InvokeStaticOrDirect method_name:Main.unprofiledCallee
+
+  /// CHECK-START: int Main.callUnprofiled(int) inliner (after)
+  /// CHECK-NOT:   InvokeStaticOrDirect method_name:Main.unprofiledCallee
+  public static int callUnprofiled(int a) {
+    return unprofiledCallee(a);
+  }
+
+  public static void main(String[] args) {
+    int expected3 = ((1 * 31 + 1) * 31 + 2) * 31 + 3;
+    int expected9 = expected3;
+    for (int i = 4; i <= 9; i++) {
+      expected9 = expected9 * 31 + i;
+    }
+    expectEquals(expected9, callHot(1));
+    expectEquals(expected3, callStartupOnly(1));
+    expectEquals(expected3, callUnprofiled(1));
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Random;
+import java.util.zip.CRC32;
+
+public class Main {
+
+  /// CHECK-START: void Main.$noinline$updateInt(java.util.zip.CRC32, int) inliner (after)
+  /// CHECK-DAG: <<Arg:i\d+>>     ParameterValue
+  /// CHECK-DAG: <<Crc:i\d+>>     InstanceFieldGet
+  /// CHECK-DAG: <<Res:i\d+>>     InvokeStaticOrDirect [<<Crc>>,<<Arg>>{{(,[ij]\d+)?}}] intrinsic:CRC32Update
+  /// CHECK-DAG:                  InstanceFieldSet [{{l\d+}},<<Res>>]
+
+  // The byte is folded in with eight shift/xor steps of the reflected polynomial 0xedb88320,
+  // without a call to the native library.
+  /// CHECK-START-X86_64: void Main.$noinline$updateInt(java.util.zip.CRC32, int) disassembly (after)
+  /// CHECK:                      InvokeStaticOrDirect intrinsic:CRC32Update
+  /// CHECK-NEXT:                 movzxb
+  /// CHECK-NEXT:                 mov
+  /// CHECK-NEXT:                 not
+  /// CHECK-NEXT:                 xor
+  /// CHECK-NEXT:                 mov
+  /// CHECK-NEXT:                 and {{\w+}}, 1
+  /// CHECK-NEXT:                 neg
+  /// CHECK-NEXT:                 and {{\w+}}, -306674912
+  /// CHECK-NEXT:                 shr
+  /// CHECK-NEXT:                 xor
+  /// CHECK-NOT:                  call
+  /// CHECK:                      not
+  /// CHECK-NOT:                  call
+  /// CHECK:                      InstanceFieldSet
+  public static void $noinline$updateInt(CRC32 crc32, int b) {
+    crc32.update(b);
+  }
+
+  // Checksum of `data` computed one byte at a time with the intrinsic.
+  private static long crc32UsingUpdateInt(int[] data) {
+    CRC32 crc32 = new CRC32();
+    for (int b : data) {
+      $noinline$updateInt(crc32, b);
+    }
+    return crc32.getValue();
+  }
+
+  // Checksum of the low bytes of `data` computed by the library.
+  private static long crc32UsingLibrary(int[] data) {
+    byte[] bytes = new byte[data.length];
+    for (int i = 0; i < data.length; ++i) {
+      bytes[i] = (byte) data[i];
+    }
+    CRC32 crc32 = new CRC32();
+    crc32.update(bytes, 0, bytes.length);
+    return crc32.getValue();
+  }
+
+  public static void main(String[] args) {
+    // Single bytes, with and without high bits set, which must be ignored.
+    for (int b = 0; b < 256; ++b) {
+      for (int high : new int[] { 0, 0x100, 0x12345600, 0xffffff00, Integer.MIN_VALUE }) {
+        int[] data = new int[] { high | b };
+        expectEquals(crc32UsingLibrary(data), crc32UsingUpdateInt(data));
+      }
+    }
+
+    // Known checksums.
+    expectEquals(0xD202EF8DL, crc32UsingUpdateInt(new int[] { 0 }));
+    expectEquals(0xFF000000L, crc32UsingUpdateInt(new int[] { -1 }));
+    expectEquals(0xCBF43926L,
+                 crc32UsingUpdateInt(new int[] { '1', '2', '3', '4', '5', '6', '7', '8', '9' }));
+
+    // Random sequences.
+    Random random = new Random(42);
+    for (int i = 0; i < 100; ++i) {
+      int[] data = new int[random.nextInt(64) + 1];
+      for (int j = 0; j < data.length; ++j) {
+        data[j] = random.nextInt();
+      }
+      expectEquals(crc32UsingLibrary(data), crc32UsingUpdateInt(data));
+    }
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
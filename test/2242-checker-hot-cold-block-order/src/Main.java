@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  // The throwing block comes first in dex order, but its code must be emitted after the code
+  // of the return.
+  /// CHECK-START-{ARM64,X86_64}: int Main.$noinline$getNonNegative(int[], int) disassembly (after)
+  /// CHECK:      Throw
+  /// CHECK-NEXT: <<Cold:0x[0-9a-f]+>>:
+  /// CHECK:      Return
+  /// CHECK-NEXT: <<Hot:0x[0-9a-f]+>>:
+  /// CHECK-EVAL: int("<<Cold>>", 16) > int("<<Hot>>", 16)
+  public static int $noinline$getNonNegative(int[] array, int index) {
+    if (index < 0) {
+      throw new IllegalArgumentException("Negative index: " + index);
+    }
+    return array[index];
+  }
+
+  public static void main(String[] args) {
+    int[] array = new int[] { 1, 2, 3 };
+    expectEquals(1, $noinline$getNonNegative(array, 0));
+    expectEquals(3, $noinline$getNonNegative(array, 2));
+    try {
+      $noinline$getNonNegative(array, -1);
+      throw new Error("Expected Error");
+    } catch (IllegalArgumentException expected) {
+      expectEquals("Negative index: -1", expected.getMessage());
+    }
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(String expected, String result) {
+    if (!expected.equals(result)) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
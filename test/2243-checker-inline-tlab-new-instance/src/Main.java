@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  /// CHECK-START-X86_64: java.lang.Object Main.$noinline$newObject() disassembly (after)
+  /// CHECK:      NewInstance
+  /// CHECK-NEXT: cmp alloc_entrypoints_instrumented
+  /// CHECK-NEXT: jnz/ne
+  /// CHECK-NEXT: mov
+  /// CHECK-NEXT: mov thread_local_pos
+  /// CHECK-NEXT: add
+  /// CHECK-NEXT: cmp thread_local_end
+  /// CHECK-NEXT: jnbe/a
+  /// CHECK-NEXT: mov thread_local_pos
+  /// CHECK-NEXT: mov thread_local_objects
+  /// CHECK-NEXT: add
+  /// CHECK-NEXT: mov thread_local_objects
+  /// CHECK-NOT:  call
+  /// CHECK:      Return
+  /// CHECK:      NewInstanceSlowPathX86_64
+  /// CHECK:      call pAllocObjectInitialized
+
+  /// CHECK-START-ARM64: java.lang.Object Main.$noinline$newObject() disassembly (after)
+  /// CHECK:      NewInstance
+  /// CHECK-NEXT: ldr alloc_entrypoints_instrumented
+  /// CHECK-NEXT: cbnz
+  /// CHECK-NEXT: ldr
+  /// CHECK-NEXT: ldr thread_local_pos
+  /// CHECK-NEXT: ldr thread_local_end
+  /// CHECK-NEXT: add
+  /// CHECK-NEXT: cmp
+  /// CHECK-NEXT: b.hi
+  /// CHECK-NEXT: str thread_local_pos
+  /// CHECK-NEXT: ldr thread_local_objects
+  /// CHECK-NEXT: add
+  /// CHECK-NEXT: str thread_local_objects
+  /// CHECK:      dmb ishst
+  /// CHECK-NOT:  blr
+  /// CHECK:      Return
+  /// CHECK:      NewInstanceSlowPathARM64
+  /// CHECK:      ldr pAllocObjectInitialized
+  /// CHECK-NEXT: blr
+  public static Object $noinline$newObject() {
+    return new Object();
+  }
+
+  public static void main(String[] args) {
+    // Allocate enough objects to fill several TLABs, so that both the inline fast path and
+    // the slow path are taken.
+    Object[] objects = new Object[100000];
+    for (int i = 0; i < objects.length; ++i) {
+      objects[i] = $noinline$newObject();
+    }
+    Runtime.getRuntime().gc();
+    for (int i = 0; i < objects.length; ++i) {
+      if (objects[i].getClass() != Object.class) {
+        throw new Error("Unexpected class " + objects[i].getClass() + " at " + i);
+      }
+      if (i != 0 && objects[i] == objects[i - 1]) {
+        throw new Error("Same object allocated twice at " + i);
+      }
+    }
+    System.out.println("passed");
+  }
+}
@@ -23,6 +23,8 @@ public class Main {
         testNoArgs();
         testInline();
         testEquals();
+        testConstructorArgs();
+        testEmptyStrings();
         System.out.println("passed");
     }
 
@@ -291,6 +293,45 @@ public class Main {
       }
     }
 
+    /// CHECK-START: java.lang.String Main.$noinline$appendWithCapacity(java.lang.String, int) instruction_simplifier (before)
+    /// CHECK-NOT:              StringBuilderAppend
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendWithCapacity(java.lang.String, int) instruction_simplifier (after)
+    /// CHECK:                  StringBuilderAppend
+    public static String $noinline$appendWithCapacity(String s, int i) {
+        return new StringBuilder(64).append(s).append(i).toString();
+    }
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendToConstantString(java.lang.String, int) instruction_simplifier (before)
+    /// CHECK-NOT:              StringBuilderAppend
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendToConstantString(java.lang.String, int) instruction_simplifier (after)
+    /// CHECK:                  StringBuilderAppend
+    public static String $noinline$appendToConstantString(String s, int i) {
+        return new StringBuilder("x=").append(s).append(i).toString();
+    }
+
+    public static void testConstructorArgs() {
+        assertEquals("abc42", $noinline$appendWithCapacity("abc", 42));
+        assertEquals("null-1", $noinline$appendWithCapacity(null, -1));
+        assertEquals("x=abc42", $noinline$appendToConstantString("abc", 42));
+        assertEquals("x=null-1", $noinline$appendToConstantString(null, -1));
+    }
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendEmptyStrings(java.lang.String, int) instruction_simplifier (after)
+    /// CHECK:                  StringBuilderAppend
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendEmptyStrings(java.lang.String, int) instruction_simplifier (after)
+    /// CHECK-NOT:              InvokeVirtual
+    public static String $noinline$appendEmptyStrings(String s, int i) {
+        return new StringBuilder("").append(s).append("").append(i).append("").toString();
+    }
+
+    public static void testEmptyStrings() {
+        assertEquals("abc42", $noinline$appendEmptyStrings("abc", 42));
+        assertEquals("null-1", $noinline$appendEmptyStrings(null, -1));
+    }
+
     public static void assertEquals(String expected, String actual) {
         if (!expected.equals(actual)) {
             throw new AssertionError("Expected: " + expected + ", actual: " + actual);
@@ -46,6 +46,12 @@ target_config = {
             'ART_USE_CXX_INTERPRETER' : 'true'
         }
     },
+    'art-interpreter-threaded' : {
+        'run-test' : ['--interpreter'],
+        'env' : {
+            'ART_USE_THREADED_INTERPRETER' : 'true'
+        }
+    },
     'art-interpreter-access-checks' : {
         'run-test' : ['--interp-ac']
     },